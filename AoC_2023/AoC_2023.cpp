@@ -10,59 +10,24 @@
 #include <string>
 #include <tuple>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <format>
 #include <ranges>
+#include <chrono>
+#include <utility>
 
 using namespace std::string_literals;
 using namespace std::placeholders;
 
 namespace fs = std::filesystem;
 
-using structure_data = std::tuple<std::string, int, int, int, std::function<void (int, my_lines, bool)>>;
-
 const std::string        strAoC{ "Advent of Code 2023" };
 const std::array<int, 5> cols = { 50, 220, 400, 580, 750 };
 const std::array<int, 5> rows = { 30, 150, 270, 390, 510 };
 const int iWidth  = 161;
 const int iHeight = 111;
 
-void help(std::string const& strText, int part, my_lines file, bool) {
-   std::cout << std::format("{} / Part {}\n{}\n", strText, part, file.theText);
-   std::cout << "Unfortunately, there is no solution for this puzzle yet.\n"
-             << "Perhaps you opened the door too early, and we haven't reached the day yet.\n";
-   //QMessageBox::information(nullptr, strAoC.c_str(), QString::fromStdString(strMessage));
-   }
-
-std::vector<structure_data> advent_actions = {
-   { structure_data{ "btnDay01"s, 0, 0,  1, aoc2023_day1::Riddle  } },
-   { structure_data{ "btnDay02"s, 0, 1,  2, aoc2023_day2::Riddle  } },
-   { structure_data{ "btnDay03"s, 0, 2,  3, aoc2023_day3::Riddle  } },
-   { structure_data{ "btnDay04"s, 0, 3,  4, aoc2023_day4::Riddle  } },
-   { structure_data{ "btnDay05"s, 0, 4,  5, aoc2023_day5::Riddle  } },
-   { structure_data{ "btnDay06"s, 1, 0,  6, aoc2023_day6::Riddle  } },
-   { structure_data{ "btnDay07"s, 1, 1,  7, aoc2023_day7::Riddle  } },
-   { structure_data{ "btnDay08"s, 1, 2,  8, aoc2023_day8::Riddle  } },
-   { structure_data{ "btnDay09"s, 1, 3,  9, aoc2023_day9::Riddle  } },
-   { structure_data{ "btnDay10"s, 1, 4, 10, aoc2023_day10::Riddle } },
-   { structure_data{ "btnDay11"s, 2, 0, 11, aoc2023_day11::Riddle } },
-   { structure_data{ "btnDay12"s, 2, 1, 12, aoc2023_day12::Riddle } },
-   { structure_data{ "btnDay13"s, 2, 2, 13, aoc2023_day13::Riddle } },
-   { structure_data{ "btnDay14"s, 2, 3, 14, bind(help, "Day 14", _1, _2, _3)  } },
-   { structure_data{ "btnDay15"s, 2, 4, 15, aoc2023_day15::Riddle } },
-   { structure_data{ "btnDay16"s, 3, 0, 16, aoc2023_day16::Riddle } },
-   { structure_data{ "btnDay17"s, 3, 1, 17, bind(help, "Day 17", _1, _2, _3)  } },
-   { structure_data{ "btnDay18"s, 3, 2, 18, bind(help, "Day 18", _1, _2, _3)  } },
-   { structure_data{ "btnDay19"s, 3, 3, 19, bind(help, "Day 19", _1, _2, _3)  } },
-   { structure_data{ "btnDay20"s, 3, 4, 20, bind(help, "Day 20", _1, _2, _3)  } },
-   { structure_data{ "btnDay21"s, 4, 0, 21, bind(help, "Day 21", _1, _2, _3)  } },
-   { structure_data{ "btnDay22"s, 4, 1, 22, bind(help, "Day 22", _1, _2, _3)  } },
-   { structure_data{ "btnDay23"s, 4, 2, 23, bind(help, "Day 23", _1, _2, _3)  } },
-   { structure_data{ "btnDay24"s, 4, 3, 24, bind(help, "Day 24", _1, _2, _3)  } },
-   { structure_data{ "btnDay25"s, 4, 4, 25, bind(help, "Day 25", _1, _2, _3)  } }
-};
-
-
 TStreamWrapper old_cout(std::cout), old_cerr(std::cerr), old_clog(std::clog);
 
 
@@ -73,26 +38,82 @@ void AoC_2023::CheckDay(int day) {
    }
 
 
-fs::path BuildInput(int day, bool test, std::string const& strApplication) {
-   // build the input file name from the day and part, selectively for test or production data
-   std::string strInput = std::format("../../../Input/{}/day{}.txt", (test ? "Test" : "Prod"), day);
-   fs::path executableDir = fs::path(strApplication).parent_path();
-   return fs::canonical(executableDir / fs::path(strInput));
-   }
-
 void AoC_2023::ShowData(int day) {
    ui.memOutput->clear();
    ui.memError->clear();
    CheckDay(day);
    bool test = ui.chkUseTestData->isChecked();
    auto file_path = BuildInput(day, test, strApplication);
-   std::string strBuffer;
-   for(auto const& line : my_lines(GetContent(file_path, strBuffer))) {
+   TInputSource source(file_path, EInputMode::automatic);
+   for(auto const& line : my_lines(source.Content())) {
       std::cout << line << '\n';
       }
   }
 
-void AoC_2023::CallRiddle(int day, std::function<void(int, my_lines, bool)> func) {
+void AoC_2023::SetRunning(bool running) {
+   boRunning = running;
+   ui.btnCancel->setEnabled(running);
+   ui.btnAction->setEnabled(!running);
+   ui.btnShow->setEnabled(!running);
+   if (running) {
+      theProgress.Reset();
+      progressBar->setRange(0, 0);
+      progressBar->show();
+      progressTimer->start();
+      }
+   else {
+      progressTimer->stop();
+      progressBar->hide();
+      }
+   }
+
+void AoC_2023::UpdateProgress() {
+   const auto steps  = theProgress.steps.load(std::memory_order_relaxed);
+   const auto states = theProgress.states.load(std::memory_order_relaxed);
+   const auto total  = theProgress.total.load(std::memory_order_relaxed);
+   // without a total the bar shows only that the riddle is busy
+   if (total > 0) {
+      progressBar->setRange(0, 1000);
+      progressBar->setValue(static_cast<int>(std::min(steps, total) * 1000 / total));
+      }
+   else progressBar->setRange(0, 0);
+   statusLabel->setText(QString::fromStdString(total > 0 ? std::format("{} of {} steps, {} states", steps, total, states)
+                                                          : std::format("{} steps, {} states", steps, states)));
+   }
+
+void AoC_2023::WatchInputs(bool watch) {
+   if (!watch) {
+      theWatcher.reset();
+      std::clog << "watch of the input files stopped." << std::endl;
+      return;
+      }
+   try {
+      theWatcher.emplace(fs::path(strApplication).parent_path() / "../../../Input", [this](std::vector<fs::path> const& files) {
+                            for (auto const& file_path : files)
+                               if (auto input = WatchedInput(file_path); input) emit InputChanged(input->day, input->test);
+                            });
+      std::clog << "watching \"" << theWatcher->Directory().string() << "\" ("
+                << (theWatcher->Polling() ? "compared in intervals" : "inotify") << ")" << std::endl;
+      }
+   catch (std::exception& ex) {
+      std::cerr << "the input files can't watched: " << ex.what() << '\n';
+      ui.chkWatch->setChecked(false);
+      }
+   }
+
+void AoC_2023::SolveChanged(int day, bool test) {
+   // only the kind of input which is selected, the part is taken from the window in CallRiddle
+   if (!theWatcher || test != ui.chkUseTestData->isChecked()) return;
+   if (boRunning) thePendingDay = day;
+   else CallRiddle(day);
+   }
+
+void AoC_2023::CallRiddle(int day) {
+   if (boRunning) {
+      std::clog << "a riddle is still running, cancel it before a new one is started." << std::endl;
+      return;
+      }
+
    try {
       // clear the user interface und reset it
       ui.memOutput->clear();
@@ -106,6 +127,9 @@ void AoC_2023::CallRiddle(int day, std::function<void(int, my_lines, bool)> func
       bool test    = ui.chkUseTestData->isChecked();
       int part     = ui.chkSecondPart->isChecked() ? 2 : 1;
       bool verbose = ui.chkVerbose->isChecked();
+      riddle_run_options run_options { .count_allocations = ui.chkMemory->isChecked(),
+                                       .hardware_counters = ui.chkCounters->isChecked(),
+                                       .cache = ui.chkCache->isChecked() ? &*theCache : nullptr };
 
       CheckDay(day);
       std::string strDay;
@@ -119,7 +143,7 @@ void AoC_2023::CallRiddle(int day, std::function<void(int, my_lines, bool)> func
 
       ui.btnAction->setEnabled(true);
       ui.btnShow->setEnabled(true);
-      connect(ui.btnAction, &QPushButton::clicked, this, std::bind(&AoC_2023::CallRiddle, this, day, func));
+      connect(ui.btnAction, &QPushButton::clicked, this, std::bind(&AoC_2023::CallRiddle, this, day));
       connect(ui.btnShow,   &QPushButton::clicked, this, std::bind(&AoC_2023::ShowData, this, day));
 
       auto file_path = BuildInput(day, test, strApplication);
@@ -132,18 +156,39 @@ void AoC_2023::CallRiddle(int day, std::function<void(int, my_lines, bool)> func
       if (day < strThemes.size()) std::cout << " - " << strThemes[day] << "\n";
       else std::cout << "\n";
 
-      // call function and read associated inputfile in a my_lines container
-      std::string strBuffer;
-      QCoreApplication::processEvents();
-      auto func_start = std::chrono::high_resolution_clock::now();
-      func(part, my_lines(GetContent(file_path, strBuffer)), verbose);
-      auto func_ende = std::chrono::high_resolution_clock::now();
-      auto time = std::chrono::duration_cast<std::chrono::milliseconds>(func_ende - func_start);
-      std::clog << "Finished: " << strDay << " / " << part << ". part of " << strThemes[0];
-      if (day < strThemes.size()) std::clog << " (" << strThemes[day] << ")";
-      std::clog << " with input file \"" << file_path.string()
-                << " in " << time.count() / 1000.0 << " sec\n";
+      std::optional<std::chrono::milliseconds> budget;
+      if (ui.spnBudget->value() > 0) budget = std::chrono::seconds(ui.spnBudget->value());
 
+      // the phases of each run are written as trace events next to the application (chrome://tracing, Perfetto)
+      auto trace_path = fs::path(strApplication).parent_path() / std::format("trace_day{}_part{}.json", day, part);
+
+      // the riddle runs in the worker thread, the results come back with queued signals
+      SetRunning(true);
+      theWorker = std::jthread([this, day, part, file_path, trace_path, verbose, run_options, budget, strDay](std::stop_token token) {
+         try {
+            TRiddleCancellation cancellation(token, budget);
+            TProgressScope      progress(&theProgress);
+            auto [time, strMode, result, memory, counters, cached] = RunRiddle(day, part, file_path, verbose, run_options);
+
+            std::string strLog = std::format("Finished: {} / {}. part of {}", strDay, part, strThemes[0]);
+            if (day < strThemes.size()) strLog += std::format(" ({})", strThemes[day]);
+            strLog += std::format(" with input file \"{}\" ({}) {} {} sec{}\n", file_path.string(), strMode, cached ? "from the cache," : "in",
+                                  std::chrono::duration_cast<std::chrono::milliseconds>(time).count() / 1000.0, cached ? " in an earlier run" : "");
+            strLog += std::format("   memory: {}\n", MemoryText(memory));
+            if (counters) strLog += std::format("   cpu: {}\n", HardwareCountersText(*counters));
+            if (std::ofstream ofs(trace_path); ofs.is_open()) {
+               WriteChromeTrace(ofs, result);
+               strLog += std::format("phases of the riddle written to \"{}\"\n", trace_path.string());
+               }
+            emit RiddleFinished(QString::fromStdString(Render(result)), QString::fromStdString(strLog));
+            }
+         catch (my_riddle_cancelled const& ex) {
+            emit RiddleFailed(QString::fromStdString(std::format("{} / {}. part: {}", strDay, part, ex.what())));
+            }
+         catch (std::exception& ex) {
+            emit RiddleFailed(QString::fromStdString(std::format("error in Caller, message: {}", ex.what())));
+            }
+         });
       }
    catch(std::exception& ex) {
       std::cerr << "error in Caller, message: " << ex.what() << '\n';
@@ -152,6 +197,7 @@ void AoC_2023::CallRiddle(int day, std::function<void(int, my_lines, bool)> func
 
 AoC_2023::AoC_2023(std::string const& strAppl, QWidget *parent) : QMainWindow(parent) {
    strApplication = strAppl;
+   theCache.emplace(fs::path(strApplication).parent_path() / "riddle_cache", TResultCache::BuildFingerprint(strApplication));
    ui.setupUi(this);
    output = ui.memError;
    ui.statusBar->setLayoutDirection(Qt::LayoutDirection::RightToLeft);
@@ -159,6 +205,13 @@ AoC_2023::AoC_2023(std::string const& strAppl, QWidget *parent) : QMainWindow(pa
    statusLabel->setObjectName("sbMain");
    statusLabel->setText("sbMain");
    ui.statusBar->addPermanentWidget(statusLabel);
+   progressBar = new QProgressBar(this);
+   progressBar->setMaximumWidth(200);
+   progressBar->hide();
+   ui.statusBar->addPermanentWidget(progressBar);
+   progressTimer = new QTimer(this);
+   progressTimer->setInterval(100);
+   connect(progressTimer, &QTimer::timeout, this, &AoC_2023::UpdateProgress);
 
    ui.tabContrl->setTabText(0, "Advent Calendar");
    ui.tabContrl->setTabText(1, "daily Riddle");
@@ -183,9 +236,26 @@ AoC_2023::AoC_2023(std::string const& strAppl, QWidget *parent) : QMainWindow(pa
        btn->setAutoFillBackground(true);
        btn->setStyleSheet("border: none;");
        btn->show();
-       connect(btn, &QPushButton::clicked, this, std::bind(&AoC_2023::CallRiddle, this, std::get<3>(data), std::get<4>(data)));
+       connect(btn, &QPushButton::clicked, this, std::bind(&AoC_2023::CallRiddle, this, std::get<3>(data)));
        }
 
+   connect(this, &AoC_2023::RiddleFinished, this, [this](QString strResult, QString strLog) {
+                                                      std::cout << strResult.toStdString();
+                                                      std::clog << strLog.toStdString();
+                                                      SetRunning(false);
+                                                      if (auto day = std::exchange(thePendingDay, std::nullopt); day) CallRiddle(*day);
+                                                      }, Qt::QueuedConnection);
+   connect(this, &AoC_2023::RiddleFailed, this, [this](QString strMessage) {
+                                                      std::cerr << strMessage.toStdString() << '\n';
+                                                      std::clog << strMessage.toStdString() << std::endl;
+                                                      SetRunning(false);
+                                                      if (auto day = std::exchange(thePendingDay, std::nullopt); day) CallRiddle(*day);
+                                                      }, Qt::QueuedConnection);
+   connect(this, &AoC_2023::InputChanged, this, &AoC_2023::SolveChanged, Qt::QueuedConnection);
+   connect(ui.chkWatch, &QCheckBox::toggled, this, &AoC_2023::WatchInputs);
+   connect(ui.btnCancel, &QPushButton::clicked, this, [this]() { theWorker.request_stop(); });
+   ui.btnCancel->setEnabled(false);
+
    connect(ui.btnTest, &QPushButton::clicked, this, [this]() { Test(); });
    connect(ui.btnClose, &QPushButton::clicked, this, [this]() { this->close(); });
    connect(ui.btnCalendar, &QPushButton::clicked, this, [this]() { this->ui.tabContrl->setCurrentIndex(0);
@@ -203,6 +273,11 @@ AoC_2023::AoC_2023(std::string const& strAppl, QWidget *parent) : QMainWindow(pa
    }
 
 AoC_2023::~AoC_2023() {
+   // no more changes are sent to the window
+   theWatcher.reset();
+   // the riddle is cancelled and joined while the streams still write into the window
+   theWorker.request_stop();
+   if (theWorker.joinable()) theWorker.join();
    old_cout.Reset();
    old_cerr.Reset();
    }
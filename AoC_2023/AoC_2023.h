@@ -1,11 +1,17 @@
 ﻿#pragma once
 
 #include "AoC_lib.h"
+#include "AoC_Cache.h"
+#include "AoC_Watch.h"
 
 #include <QtWidgets/QMainWindow>
+#include <QProgressBar>
+#include <QTimer>
 #include <QString>
 #include <string>
 #include <functional>
+#include <optional>
+#include <thread>
 
 #include "ui_AoC_2023.h"
 
@@ -19,13 +25,34 @@ public:
 
     static inline QTextEdit* output;
 
+signals:
+    /// sent by the worker thread, queued to the thread of the window
+    void RiddleFinished(QString strResult, QString strLog);
+    void RiddleFailed(QString strMessage);
+    /// sent by the watcher thread when the input file of the day changed
+    void InputChanged(int day, bool test);
+
 private:
    std::string strApplication;
     Ui::AoC_2023Class ui;
     QLabel* statusLabel;
+    QProgressBar* progressBar;
+    QTimer* progressTimer;
+    bool boRunning = false;
+    my_progress theProgress;    ///< written by the riddle in the worker, polled by progressTimer
+    std::optional<TResultCache> theCache;   ///< answers of earlier runs in riddle_cache next to the application
 
     void ShowData(int day);
-    void CallRiddle(int day, std::function<void(int, my_lines, bool)> func);
+    void CallRiddle(int day);
+    void SetRunning(bool running);
+    void UpdateProgress();
+    void WatchInputs(bool watch);
+    void SolveChanged(int day, bool test);
 
     void CheckDay(int day);
+
+    std::optional<TInputWatcher> theWatcher;   ///< watches ../../../Input when chkWatch is checked
+    std::optional<int> thePendingDay;          ///< changed input while a riddle is running, solved after it
+
+    std::jthread theWorker;   ///< runs the riddle, the stop token cancels it. last member, joined first
 };
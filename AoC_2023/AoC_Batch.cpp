@@ -0,0 +1,166 @@
+#include "AoC_Batch.h"
+
+#include <fstream>
+#include <format>
+#include <algorithm>
+#include <stdexcept>
+#include <mutex>
+#include <memory>
+#include <semaphore>
+#include <deque>
+
+namespace {
+
+   /// field for a CSV line, quoted when it contains a separator, quote or line break
+   std::string EscapeCsv(std::string_view text) {
+      if (text.find_first_of(",\"\r\n") == std::string_view::npos) return std::string { text };
+      std::string result = "\"";
+      for (char c : text) {
+         if (c == '"') result += '"';
+         result += c;
+         }
+      return result += '"';
+      }
+
+   /// first line of the error output of a riddle, the days write their exceptions to std::cerr
+   std::string_view FirstLine(std::string_view text) {
+      return text.substr(0, text.find('\n'));
+      }
+
+   }
+
+std::vector<fs::path> BatchInputs(fs::path const& source) {
+   std::vector<fs::path> inputs;
+   if (fs::is_directory(source)) {
+      for (auto const& entry : fs::directory_iterator(source))
+         if (entry.is_regular_file()) inputs.emplace_back(entry.path());
+      std::ranges::sort(inputs);
+      return inputs;
+      }
+
+   std::ifstream ifs(source);
+   if (!ifs.is_open()) throw std::runtime_error(std::format("directory or manifest \"{}\" can't opened", source.string()));
+   for (std::string strLine; std::getline(ifs, strLine); ) {
+      if (auto pos = strLine.find('#'); pos != std::string::npos) strLine.erase(pos);
+      if (strLine.find_first_not_of(" \t\r") == std::string::npos) continue;
+      auto strPath = trim(std::string_view(strLine));
+      fs::path path(strPath);
+      inputs.emplace_back(path.is_absolute() ? path : source.parent_path() / path);
+      }
+   return inputs;
+   }
+
+batch_result RunBatch(batch_options const& options, std::ostream& csv) {
+   auto const& func = FindRiddle(options.day);
+   const auto inputs = BatchInputs(options.source);
+
+   // the riddles run in the pool of the process together with their parallel parts, never more busy threads than cores
+   auto& pool = TThreadPool::Instance();
+   const size_t jobs     = options.jobs > 0 ? options.jobs : pool.Concurrency();
+   const size_t prefetch = options.prefetch > 0 ? options.prefetch : 2 * jobs;
+
+   batch_result result { .inputs = inputs.size() };
+   std::mutex csv_mutex;
+   auto write = [&](size_t index, fs::path const& input, std::string_view strAnswer, std::chrono::nanoseconds time,
+                    std::string_view strStatus, std::string_view strMessage) {
+      std::scoped_lock lock(csv_mutex);
+      csv << std::format("{},{},{},{:.3f},{},{}\n", index, EscapeCsv(input.string()), EscapeCsv(strAnswer), time.count() / 1'000'000.0,
+                         strStatus, EscapeCsv(strMessage));
+      if (strStatus == "ok") ++result.answered;
+      else ++result.failed;
+      result.sum += time;
+      };
+   csv << "index,input,answer,time_ms,status,message\n";
+
+   // the calling thread reads the inputs and is the only one waiting for the slots
+   std::counting_semaphore<> slots(static_cast<std::ptrdiff_t>(std::min<size_t>(prefetch, std::counting_semaphore<>::max())));
+
+   // inputs read and waiting for a runner, at most 'jobs' runners solve them in the pool
+   std::mutex ready_mutex;
+   std::deque<std::pair<size_t, std::shared_ptr<TInputSource>>> ready;
+   size_t runners = 0;
+
+   auto solve = [&](size_t index, std::shared_ptr<TInputSource> source) {
+      my_captured_output output;
+      riddle_result      answer;
+      std::string        strError;
+      auto func_start = std::chrono::steady_clock::now();
+      try {
+         TOutputCapture capture(&output);
+         TRiddleArena   arena(riddle_arena_options);
+         answer = func(options.part, my_lines(source->Content()), false);
+         }
+      catch (std::exception& ex) {
+         strError = ex.what();
+         }
+      auto func_ende = std::chrono::steady_clock::now();
+      auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(func_ende - func_start);
+
+      if (!strError.empty())        write(index, inputs[index], "", time, "error", strError);
+      else if (!answer.HasAnswer()) write(index, inputs[index], "", time, "no answer", FirstLine(output.strErr));
+      else                          write(index, inputs[index], AnswerText(answer), time, "ok", "");
+      source.reset();   // the slot is free when the input is released
+      slots.release();
+      };
+
+   // a runner ends when no input is ready, the calling thread starts a new one for the next input
+   auto runner = [&]() {
+      for (;;) {
+         std::pair<size_t, std::shared_ptr<TInputSource>> next;
+         {
+         std::scoped_lock lock(ready_mutex);
+         if (ready.empty()) {
+            --runners;
+            return;
+            }
+         next = std::move(ready.front());
+         ready.pop_front();
+         }
+         solve(next.first, std::move(next.second));
+         }
+      };
+
+   TCaptureBuffer capture_out(std::cout, &my_captured_output::strOut);
+   TCaptureBuffer capture_err(std::cerr, &my_captured_output::strErr);
+   TCaptureBuffer capture_log(std::clog, &my_captured_output::strErr);
+
+   auto wall_start = std::chrono::steady_clock::now();
+   {
+   TTaskGroup group(pool);
+   for (size_t index = 0; index < inputs.size(); ++index) {
+      // the calling thread reads and solves too, a pool without workers (one hardware thread) needs it. without
+      // a job to run the other threads solve all inputs in the slots and release them
+      while (!slots.try_acquire())
+         if (!pool.RunOne(true)) {
+            slots.acquire();
+            break;
+            }
+      std::shared_ptr<TInputSource> source;
+      try {
+         source = std::make_shared<TInputSource>(inputs[index], EInputMode::automatic, my_mapping_options { .populate = true, .sequential = true });
+         }
+      catch (std::exception& ex) {
+         write(index, inputs[index], "", { }, "input", ex.what());
+         slots.release();
+         continue;
+         }
+
+      bool boStart = false;
+      {
+      std::scoped_lock lock(ready_mutex);
+      ready.emplace_back(index, std::move(source));
+      if (runners < jobs) {
+         ++runners;
+         boStart = true;
+         }
+      }
+      if (boStart) group.RunJob(runner);
+      }
+   group.Wait();
+   }
+   auto wall_ende = std::chrono::steady_clock::now();
+
+   result.wall = std::chrono::duration_cast<std::chrono::nanoseconds>(wall_ende - wall_start);
+   csv.flush();
+   return result;
+   }
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "aoc_lib.h"
+#include "AoC_Riddles.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+
+/// settings to solve one day and part for many inputs
+struct batch_options {
+   int      day  = 0;
+   int      part = 1;
+   fs::path source;         ///< directory with the input files or manifest with a path in each line
+   size_t   jobs     = 0;   ///< riddles running at the same time, 0 = threads of the pool
+   size_t   prefetch = 0;   ///< inputs read ahead of the running riddles, 0 = 2 * jobs
+   };
+
+/// summary of a batch, the results of the inputs are written as CSV while they are finished
+struct batch_result {
+   size_t                   inputs   = 0;
+   size_t                   answered = 0;
+   size_t                   failed   = 0;   ///< input couldn't read, exception or no answer of the riddle
+   std::chrono::nanoseconds wall { 0 };
+   std::chrono::nanoseconds sum  { 0 };    ///< sum of the times of the riddles
+   };
+
+/// files of the directory sorted by name, or the lines of the manifest (# comments, relative to the manifest)
+std::vector<fs::path> BatchInputs(fs::path const& source);
+
+/// solve the day and part for all inputs of the source. the calling thread reads the inputs ahead, never more than
+/// prefetch inputs wait in memory. the riddles run in the pool of the process, each with a new arena, the
+/// riddle is looked up once and the per thread state of the days stays warm between the inputs.
+/// the CSV lines (index,input,answer,time_ms,status,message) are written in the order they are finished
+batch_result RunBatch(batch_options const& options, std::ostream& csv);
@@ -0,0 +1,239 @@
+#include "AoC_Benchmark.h"
+#include "AoC_Riddles.h"
+#include "AoC_Generator.h"
+
+#include <string>
+#include <format>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <stdexcept>
+#include <fstream>
+#include <array>
+#include <ranges>
+
+namespace {
+
+   /// stream buffer which discards everything, the output of the riddles isn't part of a benchmark
+   class TNullBuffer : public std::streambuf {
+      protected:
+         int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+         std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+      };
+
+   /// redirect a stream while the object exists
+   class TRedirect {
+      public:
+         TRedirect(std::ostream& stream, std::streambuf* buffer) : theStream(stream), theOld(stream.rdbuf(buffer)) { }
+         TRedirect(TRedirect const&) = delete;
+         ~TRedirect() { theStream.rdbuf(theOld); }
+      private:
+         std::ostream&   theStream;
+         std::streambuf* theOld;
+      };
+
+   }
+
+int64_t Percentile(std::vector<int64_t> const& sorted, double percent) {
+   if (sorted.empty()) return 0;
+   const auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size()));
+   return sorted[std::clamp<size_t>(rank, 1u, sorted.size()) - 1];
+   }
+
+benchmark_result BenchmarkRiddle(int day, int part, std::filesystem::path const& file_path, benchmark_options const& options) {
+   if (options.runs == 0) throw std::invalid_argument("a benchmark needs at least one measured run");
+   auto const& func = FindRiddle(day);
+
+   benchmark_result result { .day = day, .part = part, .input = file_path, .warmup = options.warmup };
+   result.samples.reserve(options.runs);
+
+   // the input is read once, every call builds its line index like a normal call
+   TInputSource source(file_path, EInputMode::automatic, { .populate = true, .sequential = true });
+
+   TNullBuffer null_buffer;
+   {
+   TRedirect out(std::cout, &null_buffer), err(std::cerr, &null_buffer);
+   for (size_t run = 0; run < options.warmup + options.runs; ++run) {
+      TRiddleArena arena(riddle_arena_options);
+      auto func_start = std::chrono::steady_clock::now();
+      func(part, my_lines(source.Content()), false);
+      auto func_ende = std::chrono::steady_clock::now();
+      if (run >= options.warmup)
+         result.samples.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(func_ende - func_start).count());
+      }
+   }
+
+   auto sorted = result.samples;
+   std::ranges::sort(sorted);
+   result.min    = sorted.front();
+   result.max    = sorted.back();
+   result.median = Percentile(sorted, 50.0);
+   result.p90    = Percentile(sorted, 90.0);
+   result.p99    = Percentile(sorted, 99.0);
+   result.mean   = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+   if (sorted.size() > 1) {
+      const double sum_sq = std::accumulate(sorted.begin(), sorted.end(), 0.0, [mean = result.mean](double sum, int64_t value) {
+                                            return sum + (value - mean) * (value - mean); });
+      result.stddev = std::sqrt(sum_sq / (sorted.size() - 1));
+      }
+   return result;
+   }
+
+void WriteJson(std::ostream& out, benchmark_result const& result) {
+   out << "{\n"
+       << std::format("  \"day\": {},\n  \"part\": {},\n  \"input\": \"{}\",\n", result.day, result.part, EscapeJson(result.input.string()))
+       << std::format("  \"unit\": \"ns\",\n  \"warmup\": {},\n  \"runs\": {},\n", result.warmup, result.samples.size())
+       << std::format("  \"min\": {},\n  \"median\": {},\n  \"p90\": {},\n  \"p99\": {},\n  \"max\": {},\n",
+                      result.min, result.median, result.p90, result.p99, result.max)
+       << std::format("  \"mean\": {:.1f},\n  \"stddev\": {:.1f},\n", result.mean, result.stddev)
+       << "  \"samples\": [";
+   for (size_t i = 0; auto sample : result.samples) out << (i++ > 0 ? ", " : "") << sample;
+   out << "]\n}\n";
+   }
+
+void WriteSummary(std::ostream& out, benchmark_result const& result) {
+   auto ms = [](auto value) { return static_cast<double>(value) / 1'000'000.0; };
+   out << std::format("day {} / part {}, {} runs after {} warmup runs\n", result.day, result.part, result.samples.size(), result.warmup)
+       << std::format("   min {:.3f} ms, median {:.3f} ms, p90 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms\n",
+                      ms(result.min), ms(result.median), ms(result.p90), ms(result.p99), ms(result.max))
+       << std::format("   mean {:.3f} ms, stddev {:.3f} ms\n", ms(result.mean), ms(result.stddev));
+   }
+
+sweep_result SweepRiddle(int day, int part, std::vector<size_t> const& scales, uint64_t seed, benchmark_options const& options) {
+   if (scales.size() < 2) throw std::invalid_argument("a sweep needs at least 2 sizes of the input");
+   auto const& generators = InputGenerators();
+   auto generator = generators.find(day);
+   if (generator == generators.end()) throw std::invalid_argument(std::format("there is no generator for the input of day {}", day));
+
+   sweep_result result { .day = day, .part = part, .strScale = generator->second.strScale };
+   for (size_t scale : scales) {
+      const auto file_path = fs::temp_directory_path() / std::format("aoc_day{}_{}_{}.txt", day, scale, seed);
+      {
+      std::ofstream ofs(file_path, std::ios::binary);
+      if (!ofs.is_open()) throw std::runtime_error(std::format("file \"{}\" can't opened", file_path.string()));
+      GenerateInput(ofs, day, scale, seed);
+      }
+      auto& point = result.points.emplace_back(sweep_point { .scale = scale, .bytes = fs::file_size(file_path) });
+      try {
+         point.result = BenchmarkRiddle(day, part, file_path, options);
+         }
+      catch (...) {
+         fs::remove(file_path);
+         throw;
+         }
+      fs::remove(file_path);
+      }
+
+   // t = c * f(n) for the class with the smallest variance of log(t) - log(f(n))
+   static const std::array<std::pair<std::string_view, double (*)(double)>, 7> classes = {{
+      { "O(1)",          [](double)   { return 1.0; } },
+      { "O(log n)",      [](double n) { return std::log(n); } },
+      { "O(n)",          [](double n) { return n; } },
+      { "O(n log n)",    [](double n) { return n * std::log(n); } },
+      { "O(n^2)",        [](double n) { return n * n; } },
+      { "O(n^2 log n)",  [](double n) { return n * n * std::log(n); } },
+      { "O(n^3)",        [](double n) { return n * n * n; } }
+      }};
+
+   std::vector<std::pair<double, double>> values;   // log(n), log(t)
+   for (auto const& point : result.points)
+      if (point.scale > 1 && point.result.median > 0)
+         values.emplace_back(std::log(static_cast<double>(point.scale)), std::log(static_cast<double>(point.result.median)));
+   if (values.size() < 2) return result;
+
+   const double mean_x = std::accumulate(values.begin(), values.end(), 0.0, [](double sum, auto const& v) { return sum + v.first; }) / values.size();
+   const double mean_y = std::accumulate(values.begin(), values.end(), 0.0, [](double sum, auto const& v) { return sum + v.second; }) / values.size();
+   double sxy = 0.0, sxx = 0.0;
+   for (auto const& [x, y] : values) {
+      sxy += (x - mean_x) * (y - mean_y);
+      sxx += (x - mean_x) * (x - mean_x);
+      }
+   result.exponent = sxx > 0.0 ? sxy / sxx : 0.0;
+
+   double best = std::numeric_limits<double>::max();
+   for (auto const& [strName, func] : classes) {
+      std::vector<double> residuals;
+      for (auto const& [x, y] : values) residuals.emplace_back(y - std::log(func(std::exp(x))));
+      const double mean = std::accumulate(residuals.begin(), residuals.end(), 0.0) / residuals.size();
+      const double variance = std::accumulate(residuals.begin(), residuals.end(), 0.0, [mean](double sum, double r) {
+                                              return sum + (r - mean) * (r - mean); });
+      if (variance < best) {
+         best = variance;
+         result.strComplexity = strName;
+         }
+      }
+   return result;
+   }
+
+void WriteSweep(std::ostream& out, sweep_result const& result) {
+   out << std::format("day {} / part {}, n = {}\n", result.day, result.part, result.strScale)
+       << std::format("{:>12} {:>14} {:>14} {:>14}\n", "n", "input bytes", "median ms", "min ms");
+   for (auto const& point : result.points)
+      out << std::format("{:>12} {:>14} {:>14.3f} {:>14.3f}\n", point.scale, point.bytes,
+                         point.result.median / 1'000'000.0, point.result.min / 1'000'000.0);
+   if (result.strComplexity.empty()) out << "no fit, the times are too short\n";
+   else out << std::format("time grows with n^{:.2f}, best fit {}\n", result.exponent, result.strComplexity);
+   }
+
+bool differential_result::Passed() const {
+   return !entries.empty() && entries.front().result.HasAnswer() &&
+          std::ranges::all_of(entries | std::views::drop(1), &differential_entry::boEqual);
+   }
+
+differential_result DifferentialRiddle(int day, int part, std::filesystem::path const& file_path, benchmark_options const& options) {
+   if (options.runs == 0) throw std::invalid_argument("a differential run needs at least one measured run");
+   auto [first, last] = variant_actions.equal_range(day);
+   if (first == last) throw std::invalid_argument(std::format("there are no variants for the riddle of day {}", day));
+
+   std::vector<std::pair<std::string, riddle_func_ty const*>> implementations { { "reference", &FindRiddle(day) } };
+   for (auto const& [name, func] : std::ranges::subrange(first, last) | std::views::values) implementations.emplace_back(name, &func);
+
+   differential_result result { .day = day, .part = part, .input = file_path };
+   // all implementations get the same input, every call builds its line index like a normal call
+   TInputSource source(file_path, EInputMode::automatic, { .populate = true, .sequential = true });
+
+   // the tasks of the riddles can write too, the captured output is shared with them
+   TCaptureBuffer capture_out(std::cout, &my_captured_output::strOut);
+   TCaptureBuffer capture_err(std::cerr, &my_captured_output::strErr);
+   for (auto const& [name, func] : implementations) {
+      differential_entry entry { .strName = name };
+      std::vector<int64_t> samples;
+      my_captured_output output;
+      {
+      TOutputCapture capture(&output);
+      for (size_t run = 0; run < options.warmup + options.runs; ++run) {
+         TRiddleArena arena(riddle_arena_options);
+         auto func_start = std::chrono::steady_clock::now();
+         entry.result = (*func)(part, my_lines(source.Content()), false);
+         auto func_ende = std::chrono::steady_clock::now();
+         if (run >= options.warmup) samples.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(func_ende - func_start).count());
+         }
+      }
+      std::ranges::sort(samples);
+      entry.median = Percentile(samples, 50.0);
+      if (!entry.result.HasAnswer()) {
+         entry.strMessage = output.strErr.substr(0, output.strErr.find('\n'));
+         }
+      auto const& reference = result.entries.empty() ? entry : result.entries.front();
+      entry.boEqual = reference.result.HasAnswer() && entry.result.answer == reference.result.answer;
+      result.entries.emplace_back(std::move(entry));
+      }
+   return result;
+   }
+
+void WriteDifferential(std::ostream& out, differential_result const& result) {
+   out << std::format("day {} / part {} with input file \"{}\"\n", result.day, result.part, result.input.string())
+       << std::format("{:<20} {:>24} {:>14} {:>10}  {}\n", "implementation", "answer", "median ms", "speedup", "check");
+   const auto reference = result.entries.front().median;
+   for (auto const& entry : result.entries) {
+      const auto strAnswer = entry.result.HasAnswer() ? AnswerText(entry.result) : "-"s;
+      std::string strCheck;
+      if (!entry.result.HasAnswer())                         strCheck = "no answer: " + entry.strMessage;
+      else if (&entry == &result.entries.front())           strCheck = "reference";
+      else if (!result.entries.front().result.HasAnswer())  strCheck = "no reference";
+      else                                                  strCheck = entry.boEqual ? "equal" : "DIFFERENT";
+      out << std::format("{:<20} {:>24} {:>14.3f} {:>9.2f}x  {}\n", entry.strName, strAnswer, entry.median / 1'000'000.0,
+                         entry.median > 0 ? static_cast<double>(reference) / entry.median : 0.0, strCheck);
+      }
+   out << (result.Passed() ? "all implementations have the same answer\n" : "differential check failed\n");
+   }
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "aoc_lib.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+
+/// settings for a benchmark of one day and part
+struct benchmark_options {
+   size_t runs   = 10;   ///< measured calls
+   size_t warmup = 3;    ///< calls before the measurement, not part of the statistics
+   };
+
+/// statistics of the measured calls in nanoseconds, percentiles with the nearest rank method
+struct benchmark_result {
+   int                   day  = 0;
+   int                   part = 0;
+   std::filesystem::path input;
+   size_t                warmup = 0;
+   std::vector<int64_t>  samples;   ///< durations of the measured calls in order of the runs
+
+   int64_t min    = 0;
+   int64_t median = 0;
+   int64_t p90    = 0;
+   int64_t p99    = 0;
+   int64_t max    = 0;
+   double  mean   = 0.0;
+   double  stddev = 0.0;   ///< sample standard deviation (n - 1)
+   };
+
+/// percentile (0 - 100) of sorted values with the nearest rank method
+int64_t Percentile(std::vector<int64_t> const& sorted, double percent);
+
+/// read the input once and call the riddle warmup + runs times, each call with a new arena. the
+/// output of the riddle is discarded while the benchmark runs, the time is measured with steady_clock
+benchmark_result BenchmarkRiddle(int day, int part, std::filesystem::path const& file_path, benchmark_options const& options);
+
+/// write the result as JSON object, times in nanoseconds
+void WriteJson(std::ostream& out, benchmark_result const& result);
+
+/// short summary of the result for the console
+void WriteSummary(std::ostream& out, benchmark_result const& result);
+
+/// benchmark of one size of a generated input
+struct sweep_point {
+   size_t           scale = 0;
+   uintmax_t        bytes = 0;   ///< size of the generated input
+   benchmark_result result;
+   };
+
+/// benchmarks of a day and part with generated inputs of growing size and the fitted complexity
+struct sweep_result {
+   int                      day  = 0;
+   int                      part = 0;
+   std::string              strScale;        ///< meaning of n, from the generator
+   std::vector<sweep_point> points;
+   double                   exponent = 0.0;  ///< slope of log(time) over log(n), least squares
+   std::string              strComplexity;   ///< best fitting class, e.g. "O(n log n)"
+   };
+
+/// generate the input for every scale (AoC_Generator) in the temp directory and benchmark it, the
+/// medians are fitted against n. needs at least 2 scales
+sweep_result SweepRiddle(int day, int part, std::vector<size_t> const& scales, uint64_t seed, benchmark_options const& options);
+
+/// table of the sizes and times with the fitted complexity
+void WriteSweep(std::ostream& out, sweep_result const& result);
+
+/// one implementation of a riddle in a differential run
+struct differential_entry {
+   std::string   strName;            ///< "reference" for the function of advent_actions, else the name of the variant
+   riddle_result result;             ///< result of the last call
+   std::string   strMessage;         ///< first line of the error output of the riddle, when there is no answer
+   int64_t       median = 0;         ///< median of the measured calls in nanoseconds
+   bool          boEqual = false;    ///< same answer as the reference, always false without an answer of the reference
+   };
+
+/// the reference and the variants of a day and part with the same input
+struct differential_result {
+   int                             day  = 0;
+   int                             part = 0;
+   std::filesystem::path           input;
+   std::vector<differential_entry> entries;   ///< the reference first, then the variants in the order of variant_actions
+
+   /// the reference has an answer and all variants the same one
+   bool Passed() const;
+   };
+
+/// read the input once and call the reference and every variant of the day (variant_actions) warmup + runs
+/// times on the same lines, each call with a new arena. throws std::invalid_argument for days without variants
+differential_result DifferentialRiddle(int day, int part, std::filesystem::path const& file_path, benchmark_options const& options);
+
+/// table of the implementations with answer, median and speedup against the reference
+void WriteDifferential(std::ostream& out, differential_result const& result);
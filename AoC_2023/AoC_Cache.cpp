@@ -0,0 +1,136 @@
+#include "AoC_Cache.h"
+
+#include <fstream>
+#include <sstream>
+#include <format>
+#include <variant>
+#include <thread>
+#include <system_error>
+
+namespace {
+   constexpr std::string_view cache_header = "aoc-result-cache 1";
+
+   /// rest of the line after the first space, names and labels can contain spaces
+   std::string Rest(std::istream& in) {
+      std::string strRest;
+      std::getline(in >> std::ws, strRest);
+      return strRest;
+      }
+   }
+
+uint64_t TResultCache::Key(std::string_view input, int day, int part) const {
+   const auto strKey = std::format("{:016x} {} {} {:016x}", HashBytes(input), day, part, iFingerprint);
+   return HashBytes(strKey);
+   }
+
+fs::path TResultCache::File(uint64_t key) const {
+   return theDirectory / std::format("{:016x}.txt", key);
+   }
+
+uint64_t TResultCache::BuildFingerprint(fs::path const& application) {
+   std::error_code ec;
+   const auto size = fs::file_size(application, ec);
+   const auto time = fs::last_write_time(application, ec).time_since_epoch().count();
+   #if defined(_MSC_FULL_VER)
+      const auto compiler = std::format("msvc {}", _MSC_FULL_VER);
+   #else
+      const std::string compiler = __VERSION__;
+   #endif
+   return HashBytes(std::format("{} {} {}", size, time, compiler));
+   }
+
+std::optional<cached_run> TResultCache::Find(uint64_t key) const {
+   std::ifstream ifs(File(key));
+   if (!ifs.is_open()) return { };
+
+   std::string strLine;
+   if (!std::getline(ifs, strLine) || strLine != cache_header) return { };
+
+   cached_run run;
+   bool boAnswer = false;
+   for (std::string strTag; ifs >> strTag; ) {
+      if (strTag == "day") ifs >> run.result.day;
+      else if (strTag == "part") ifs >> run.result.part;
+      else if (strTag == "label") run.result.strLabel = Rest(ifs);
+      else if (strTag == "mode") run.strMode = Rest(ifs);
+      else if (strTag == "time") {
+         int64_t time;
+         ifs >> time;
+         run.time = std::chrono::nanoseconds { time };
+         }
+      else if (strTag == "answer") {
+         std::string strKind;
+         ifs >> strKind;
+         if (strKind == "int") {
+            int64_t value;
+            ifs >> value;
+            run.result.answer = value;
+            }
+         else if (strKind == "uint128") {
+            my_uint128 value;
+            ifs >> value.high >> value.low;
+            run.result.answer = value;
+            }
+         else if (strKind == "string") run.result.answer = Rest(ifs);
+         else return { };
+         boAnswer = true;
+         }
+      else if (strTag == "phase") {
+         riddle_phase phase;
+         int64_t start, time;
+         ifs >> start >> time >> phase.depth >> phase.thread;
+         phase.start = std::chrono::nanoseconds { start };
+         phase.time  = std::chrono::nanoseconds { time };
+         phase.name  = Rest(ifs);
+         run.result.phases.emplace_back(std::move(phase));
+         }
+      else if (strTag == "counter") {
+         riddle_counter counter;
+         ifs >> counter.value;
+         counter.name = Rest(ifs);
+         run.result.counters.emplace_back(std::move(counter));
+         }
+      else return { };   // written by another version
+      if (!ifs) return { };
+      }
+   if (!boAnswer) return { };
+   return run;
+   }
+
+void TResultCache::Store(uint64_t key, cached_run const& run) const {
+   if (!run.result.HasAnswer()) return;
+
+   std::ostringstream os;
+   os << cache_header << '\n'
+      << std::format("day {}\npart {}\nlabel {}\nmode {}\ntime {}\n", run.result.day, run.result.part, run.result.strLabel,
+                     run.strMode, run.time.count());
+   std::visit([&os](auto const& value) {
+      using ty = std::decay_t<decltype(value)>;
+      if constexpr (std::is_same_v<ty, int64_t>)         os << "answer int " << value << '\n';
+      else if constexpr (std::is_same_v<ty, my_uint128>) os << "answer uint128 " << value.high << ' ' << value.low << '\n';
+      else if constexpr (std::is_same_v<ty, std::string>) os << "answer string " << value << '\n';
+      }, run.result.answer);
+   for (auto const& phase : run.result.phases)
+      os << std::format("phase {} {} {} {} {}\n", phase.start.count(), phase.time.count(), phase.depth, phase.thread, phase.name);
+   for (auto const& counter : run.result.counters)
+      os << std::format("counter {} {}\n", counter.value, counter.name);
+
+   // the cache is only an optimization, a cache which can't be written doesn't stop the riddle
+   std::error_code ec;
+   fs::create_directories(theDirectory, ec);
+   const auto file_path = File(key);
+   auto temp_path = file_path;
+   temp_path += std::format(".{}.tmp", std::hash<std::thread::id> { }(std::this_thread::get_id()));
+   {
+   std::ofstream ofs(temp_path);
+   if (!ofs.is_open()) return;
+   ofs << os.str();
+   if (!ofs) {
+      ofs.close();
+      fs::remove(temp_path, ec);
+      return;
+      }
+   }
+   fs::rename(temp_path, file_path, ec);
+   if (ec) fs::remove(temp_path, ec);
+   }
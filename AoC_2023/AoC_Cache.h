@@ -0,0 +1,43 @@
+#pragma once
+
+#include "aoc_lib.h"
+
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <optional>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+/// result of an earlier run, stored with the answer, phases and counters
+struct cached_run {
+   riddle_result            result;
+   std::chrono::nanoseconds time { 0 };
+   std::string              strMode;
+   };
+
+/// on disk cache for the results of the riddles, one file for each key in the directory. the key is the
+/// hash of the input bytes, the day, the part and the fingerprint of the application, so a new build
+/// or a changed input never uses an old answer. only results with an answer are stored
+class TResultCache {
+   public:
+      TResultCache(fs::path const& directory, uint64_t fingerprint) : theDirectory(directory), iFingerprint(fingerprint) { }
+
+      /// key of the input for the day and part
+      uint64_t Key(std::string_view input, int day, int part) const;
+
+      /// stored run for the key, empty when there is none or the file can't read
+      std::optional<cached_run> Find(uint64_t key) const;
+      /// store the run, written to a temporary file and renamed, so concurrent runs don't see half files
+      void Store(uint64_t key, cached_run const& run) const;
+
+      /// fingerprint of the build, size and time of the executable file and the compiler, every new link invalidates the cache
+      static uint64_t BuildFingerprint(fs::path const& application);
+
+   private:
+      fs::path File(uint64_t key) const;
+
+      fs::path theDirectory;
+      uint64_t iFingerprint;
+   };
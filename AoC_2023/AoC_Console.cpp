@@ -0,0 +1,365 @@
+// console runner for the riddles, build without Qt (BUILD_WITH_QT isn't defined)
+// call: AoC_Console <day> [<part>] [--input <file>] [--test] [--verbose] [--budget <ms>] [--trace <file>] [--memory] [--perf]
+//                    [--no-cache] [--benchmark <runs> [--warmup <runs>] [--json <file>]]
+//      AoC_Console --all [--test] [--jobs <n>] [--timings <file>] [--memory] [--perf] [--no-cache]
+//      AoC_Console --verify | --record [--manifest <file>]
+//      AoC_Console <day> --generate <scale> [--seed <n>] [--output <file>]
+//      AoC_Console <day> [<part>] --sweep <scale>,<scale>,... [--seed <n>] [--benchmark <runs> [--warmup <runs>]]
+//      AoC_Console <day> [<part>] --batch <directory|manifest> [--jobs <n>] [--prefetch <n>] [--csv <file>]
+//      AoC_Console <day> [<part>] --differential [--input <file>] [--test] [--benchmark <runs> [--warmup <runs>]]
+//      AoC_Console --watch [--test] [--verbose] [--budget <ms>] [--memory] [--perf] [--no-cache]
+
+#include "aoc_lib.h"
+#include "AoC_Riddles.h"
+#include "AoC_Benchmark.h"
+#include "AoC_RunAll.h"
+#include "AoC_Verify.h"
+#include "AoC_Generator.h"
+#include "AoC_Batch.h"
+#include "AoC_Watch.h"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <format>
+#include <stdexcept>
+#include <ranges>
+#include <thread>
+
+/// arguments of the console runner
+struct console_options {
+   int                     day     = 0;
+   int                     part    = 1;
+   std::optional<fs::path> input;
+   bool                    test    = false;
+   bool                    verbose = false;
+   std::optional<std::chrono::milliseconds> budget;   ///< the riddle is cancelled when it runs longer
+   std::optional<fs::path>          trace;       ///< file for the phases of the riddle as Chrome trace events
+   bool                             memory = false; ///< count the allocations of the riddle
+   bool                             perf   = false; ///< hardware counters of the riddle (linux)
+   bool                             no_cache = false; ///< solve the riddle even when the result cache knows the input
+   std::optional<benchmark_options> benchmark;   ///< set with --benchmark, the riddle runs repeated and measured
+   std::optional<fs::path>          json;        ///< file for the JSON result of the benchmark, stdout without
+   bool                             all = false; ///< run all days and parts concurrently
+   size_t                           jobs = 0;    ///< riddles at the same time for --all and --batch, 0 = hardware threads
+   std::optional<fs::path>          timings;     ///< times of earlier runs for --all, default next to the application
+   bool                             verify = false; ///< check the answers and budgets of the manifest
+   bool                             record = false; ///< write the answers of all solved riddles to the manifest
+   std::optional<fs::path>          manifest;    ///< expected answers, default riddle_answers.txt in the project directory
+   std::optional<size_t>            generate;    ///< scale of a generated input for the day, written instead of a run
+   std::vector<size_t>              sweep;       ///< scales of generated inputs for a benchmark with complexity fit
+   std::optional<uint64_t>          seed;        ///< seed for the generated inputs, default 1
+   std::optional<fs::path>          output;      ///< file for the generated input, stdout without
+   std::optional<fs::path>          batch;       ///< directory or manifest with many inputs for the day and part
+   size_t                           prefetch = 0; ///< inputs read ahead for --batch, 0 = 2 * jobs
+   std::optional<fs::path>          csv;         ///< file for the CSV results of --batch, stdout without
+   bool                             watch = false; ///< solve the day again when its input file changes
+   bool                             differential = false; ///< compare the variants of the riddle with the reference
+   };
+
+/// log of a finished run, with the allocations and hardware counters when they are measured
+void WriteFinished(std::ostream& out, int day, int part, fs::path const& file_path, riddle_run_info const& info) {
+   out << std::format("Finished: day {} / part {} with input file \"{}\" ({}) {}\n", day, part, file_path.string(), info.strMode,
+                      info.boCached ? std::format("from the cache, {:.3f} ms in an earlier run", info.time.count() / 1'000'000.0)
+                                    : std::format("in {:.3f} ms", info.time.count() / 1'000'000.0));
+   out << "   memory: " << MemoryText(info.memory) << '\n';
+   if (info.counters) out << "   cpu: " << HardwareCountersText(*info.counters) << '\n';
+   }
+
+void Usage(std::ostream& out, std::string_view strApplication) {
+   out << std::format("usage: {} <day> [<part>] [--input <file>] [--test] [--verbose] [--budget <ms>] [--trace <file>] [--memory] [--perf]\n", strApplication)
+       << "   <day>            day of the riddle (1 - 25)\n"
+       << "   <part>           part of the riddle (1 or 2), default 1\n"
+       << "   --input <file>   input file, default is the production input of the day (../../../Input/Prod/dayN.txt)\n"
+       << "   --test           use the test input of the day, when no input file is given\n"
+       << "   --verbose        additional output of the riddle\n"
+       << "   --budget <ms>    time budget in milliseconds, the riddle is cancelled when it's exceeded\n"
+       << "   --trace <file>   write the phases of the riddle as trace events (chrome://tracing, Perfetto)\n"
+       << "   --memory         count the allocations of the riddle, reported with the page faults and peak rss\n"
+       << "   --perf           hardware counters of the riddle (cycles, IPC, cache and branch misses), linux only\n"
+       << "   --no-cache       solve the riddle, without the answers of earlier runs in riddle_cache next to the application\n"
+       << "   --benchmark <n>  call the riddle n times without output and report the statistics of the times\n"
+       << "   --warmup <n>     calls before the measured runs of the benchmark, default 3\n"
+       << "   --json <file>    write the result of the benchmark as JSON to the file, default stdout\n"
+       << std::format("       {} --all [--test] [--jobs <n>] [--timings <file>] [--memory] [--perf] [--no-cache]\n", strApplication)
+       << "   --all            run all days and parts concurrently, the longest of the last run first\n"
+       << "   --jobs <n>       riddles running at the same time, default the count of hardware threads\n"
+       << "   --timings <file> times of the last run, default riddle_timings.txt next to the application\n"
+       << std::format("       {} --verify | --record [--manifest <file>]\n", strApplication)
+       << "   --verify         run the riddles of the manifest, fails for wrong answers or exceeded time or memory budgets\n"
+       << "   --record         run all solved riddles with test and production inputs and write their answers to the manifest\n"
+       << "   --manifest <file> expected answers and budgets, default ../../riddle_answers.txt from the application\n"
+       << std::format("       {} <day> --generate <scale> [--seed <n>] [--output <file>]\n", strApplication)
+       << "   --generate <n>   write a synthetic input of the day with the scale n (lines or side of the grid)\n"
+       << "   --seed <n>       seed for the random values of the generated input, default 1\n"
+       << "   --output <file>  file for the generated input, default stdout\n"
+       << std::format("       {} <day> [<part>] --sweep <n>,<n>,... [--seed <n>] [--benchmark <runs> [--warmup <runs>]]\n", strApplication)
+       << "   --sweep <list>   benchmark generated inputs of the scales and fit the time against n, default 3 runs\n"
+       << std::format("       {} <day> [<part>] --batch <directory|manifest> [--jobs <n>] [--prefetch <n>] [--csv <file>]\n", strApplication)
+       << "   --batch <source> solve all files of the directory or all paths in the manifest, results as CSV\n"
+       << "   --prefetch <n>   inputs read ahead of the running riddles, default 2 * jobs\n"
+       << "   --csv <file>     file for the CSV results, default stdout\n"
+       << std::format("       {} <day> [<part>] --differential [--input <file>] [--test] [--benchmark <runs> [--warmup <runs>]]\n", strApplication)
+       << "   --differential   run the reference and the variants of the riddle on the same input, compare the answers\n"
+       << "                    and report the speedup, default 3 runs after 1 warmup\n"
+       << std::format("       {} --watch [--test] [--verbose] [--budget <ms>] [--memory] [--perf] [--no-cache]\n", strApplication)
+       << "   --watch          watch ../../../Input, both parts of a day are solved again when its input file changes\n";
+   }
+
+console_options ParseArguments(std::vector<std::string_view> const& args) {
+   console_options options;
+   std::vector<std::string_view> positional;
+   std::optional<size_t> warmup;
+   auto value = [&args](size_t& i) {
+      if (i + 1 >= args.size()) throw std::invalid_argument(std::format("missing value after {}", args[i]));
+      return args[++i];
+      };
+   for (size_t i = 0; i < args.size(); ++i) {
+      if (args[i] == "--input") options.input = fs::path(value(i));
+      else if (args[i] == "--benchmark") options.benchmark = benchmark_options { .runs = toInt<size_t>(value(i)) };
+      else if (args[i] == "--warmup")    warmup = toInt<size_t>(value(i));
+      else if (args[i] == "--json")      options.json = fs::path(value(i));
+      else if (args[i] == "--budget")    options.budget = std::chrono::milliseconds(toInt<int64_t>(value(i)));
+      else if (args[i] == "--trace")     options.trace = fs::path(value(i));
+      else if (args[i] == "--memory")    options.memory = true;
+      else if (args[i] == "--perf")      options.perf = true;
+      else if (args[i] == "--no-cache")  options.no_cache = true;
+      else if (args[i] == "--verify")    options.verify = true;
+      else if (args[i] == "--record")    options.record = true;
+      else if (args[i] == "--manifest")  options.manifest = fs::path(value(i));
+      else if (args[i] == "--generate")  options.generate = toInt<size_t>(value(i));
+      else if (args[i] == "--seed")      options.seed = toInt<uint64_t>(value(i));
+      else if (args[i] == "--output")    options.output = fs::path(value(i));
+      else if (args[i] == "--batch")     options.batch = fs::path(value(i));
+      else if (args[i] == "--prefetch")  options.prefetch = toInt<size_t>(value(i));
+      else if (args[i] == "--csv")       options.csv = fs::path(value(i));
+      else if (args[i] == "--watch")     options.watch = true;
+      else if (args[i] == "--differential") options.differential = true;
+      else if (args[i] == "--sweep") {
+         for (auto scale : value(i) | std::views::split(',')) options.sweep.emplace_back(toInt<size_t>(std::string_view(scale.begin(), scale.end())));
+         }
+      else if (args[i] == "--all")       options.all = true;
+      else if (args[i] == "--jobs")      options.jobs = toInt<size_t>(value(i));
+      else if (args[i] == "--timings")   options.timings = fs::path(value(i));
+      else if (args[i] == "--test")    options.test = true;
+      else if (args[i] == "--verbose") options.verbose = true;
+      else if (args[i].starts_with("--")) throw std::invalid_argument(std::format("unknown option \"{}\"", args[i]));
+      else positional.emplace_back(args[i]);
+      }
+
+   if (warmup) {
+      if (!options.benchmark) throw std::invalid_argument("--warmup is only possible with --benchmark");
+      options.benchmark->warmup = *warmup;
+      }
+   if (options.json && !options.benchmark) throw std::invalid_argument("--json is only possible with --benchmark");
+   if (options.trace && (options.benchmark || options.all)) throw std::invalid_argument("--trace is only possible for a single run");
+   if ((options.memory || options.perf) && options.benchmark) throw std::invalid_argument("--memory and --perf aren't possible with --benchmark");
+   if (options.no_cache && options.benchmark) throw std::invalid_argument("--no-cache isn't necessary with --benchmark, it never uses the cache");
+   if (options.benchmark && options.benchmark->runs == 0) throw std::invalid_argument("--benchmark needs at least one run");
+
+   if (options.generate || !options.sweep.empty()) {
+      if (options.generate && !options.sweep.empty()) throw std::invalid_argument("--generate and --sweep can't be used together");
+      if (options.all || options.verify || options.record || options.input || options.test || options.json || options.trace)
+         throw std::invalid_argument("--generate and --sweep only with the day, the part and the options for them");
+      if (options.generate && options.benchmark) throw std::invalid_argument("--benchmark isn't possible with --generate");
+      if (options.output && !options.generate) throw std::invalid_argument("--output is only possible with --generate");
+      }
+   else if (options.seed || options.output) throw std::invalid_argument("--seed and --output are only possible with --generate or --sweep");
+
+   if (options.batch) {
+      if (options.all || options.verify || options.record || options.generate || !options.sweep.empty() || options.input ||
+          options.test || options.benchmark || options.trace || options.memory || options.perf || options.budget || options.no_cache)
+         throw std::invalid_argument("--batch only with the day, the part, --jobs, --prefetch and --csv");
+      }
+   else if (options.prefetch > 0 || options.csv) throw std::invalid_argument("--prefetch and --csv are only possible with --batch");
+
+   if (options.differential && (options.all || options.verify || options.record || options.generate || !options.sweep.empty() ||
+                                options.batch || options.watch || options.trace || options.json || options.memory || options.perf || options.budget))
+      throw std::invalid_argument("--differential only with the day, the part, --input, --test, --benchmark and --warmup");
+
+   if (options.watch) {
+      if (!positional.empty() || options.all || options.verify || options.record || options.benchmark || options.input || options.trace ||
+          options.generate || !options.sweep.empty() || options.batch || options.timings || options.jobs > 0)
+         throw std::invalid_argument("--watch solves the changed days, only with --test, --verbose, --budget, --memory, --perf and --no-cache");
+      return options;
+      }
+
+   if (options.verify || options.record) {
+      if (options.verify && options.record) throw std::invalid_argument("--verify and --record can't be used together");
+      if (!positional.empty() || options.all || options.benchmark || options.input || options.test || options.no_cache)
+         throw std::invalid_argument("--verify and --record use the manifest, without day, part, --all, --input, --test, --benchmark or --no-cache");
+      return options;
+      }
+   if (options.manifest) throw std::invalid_argument("--manifest is only possible with --verify or --record");
+
+   if (options.all) {
+      if (!positional.empty() || options.benchmark || options.input)
+         throw std::invalid_argument("--all runs every day and part, without day, part, --input or --benchmark");
+      return options;
+      }
+   if (options.timings) throw std::invalid_argument("--timings is only possible with --all");
+   if (options.jobs > 0 && !options.batch) throw std::invalid_argument("--jobs is only possible with --all or --batch");
+
+   if (positional.empty() || positional.size() > 2) throw std::invalid_argument("expected the day and optional the part as arguments");
+   options.day = toInt<int>(positional[0]);
+   if (positional.size() > 1) options.part = toInt<int>(positional[1]);
+
+   if (options.day < 1 || options.day > 25) throw std::invalid_argument(std::format("unexpected day {}, expected values between 1 and 25", options.day));
+   if (options.part < 1 || options.part > 2) throw std::invalid_argument(std::format("unexpected part {}, expected 1 or 2", options.part));
+   return options;
+   }
+
+int main(int argc, char* argv[]) {
+   std::ios_base::sync_with_stdio(false);
+   const std::string strApplication = argv[0];
+
+   console_options options;
+   try {
+      options = ParseArguments({ argv + 1, argv + argc });
+      }
+   catch (std::exception& ex) {
+      std::cerr << "error: " << ex.what() << '\n';
+      Usage(std::cerr, strApplication);
+      return 2;
+      }
+
+   try {
+      if (options.verify || options.record) {
+         const fs::path manifest = options.manifest ? *options.manifest
+                                                    : fs::path(strApplication).parent_path() / "../../riddle_answers.txt";
+         if (options.record) {
+            auto entries = RecordRiddles(fs::exists(manifest) ? ReadManifest(manifest) : std::vector<verify_entry> { }, strApplication);
+            WriteManifest(manifest, entries);
+            std::clog << std::format("{} answers written to \"{}\"\n", entries.size(), manifest.string());
+            return 0;
+            }
+         auto entries = ReadManifest(manifest);
+         if (entries.empty()) throw std::runtime_error(std::format("manifest \"{}\" has no entries, record them with --record", manifest.string()));
+         return WriteVerify(std::cout, VerifyRiddles(entries, strApplication)) == 0 ? 0 : 1;
+         }
+
+      // answers of earlier runs, a new build of the application or a changed input file is solved again
+      const TResultCache cache(fs::path(strApplication).parent_path() / "riddle_cache", TResultCache::BuildFingerprint(strApplication));
+      const riddle_run_options run_options { .count_allocations = options.memory, .hardware_counters = options.perf,
+                                             .cache = options.no_cache ? nullptr : &cache };
+
+      if (options.watch) {
+         // the watcher thread solves the changed days one after another, changes while a riddle runs are collected
+         TInputWatcher watcher(fs::path(strApplication).parent_path() / "../../../Input", [&](std::vector<fs::path> const& files) {
+            for (auto const& file_path : files) {
+               auto input = WatchedInput(file_path);
+               if (!input || input->test != options.test) continue;
+               for (int part : { 1, 2 }) {
+                  try {
+                     TRiddleCancellation cancellation({ }, options.budget);
+                     auto info = RunRiddle(input->day, part, file_path, options.verbose, run_options);
+                     std::cout << Render(info.result);
+                     std::cout.flush();
+                     WriteFinished(std::clog, input->day, part, file_path, info);
+                     }
+                  catch (my_riddle_cancelled const& ex) {
+                     std::cerr << "day " << input->day << " / part " << part << ": " << ex.what() << '\n';
+                     }
+                  catch (std::exception& ex) {
+                     std::cerr << "day " << input->day << " / part " << part << ": " << ex.what() << '\n';
+                     }
+                  }
+               }
+            });
+         std::clog << std::format("watching \"{}\" ({}), stop with Ctrl+C\n", watcher.Directory().string(),
+                                  watcher.Polling() ? "compared in intervals" : "inotify");
+         for (;;) std::this_thread::sleep_for(std::chrono::hours(1));
+         }
+
+      if (options.all) {
+         run_all_options all_options { .test = options.test, .jobs = options.jobs, .run = run_options,
+                                       .timings = options.timings ? *options.timings
+                                                                  : fs::path(strApplication).parent_path() / "riddle_timings.txt" };
+         auto result = RunAll(all_options, strApplication);
+         WriteRunAll(std::cout, result);
+         WriteTimings(all_options.timings, result);
+         return std::ranges::all_of(result.jobs, [](auto const& job) { return job.strError.empty() || job.input.empty(); }) ? 0 : 1;
+         }
+
+      if (options.generate) {
+         if (options.output) {
+            std::ofstream ofs(*options.output, std::ios::binary);
+            if (!ofs.is_open()) throw std::runtime_error(std::format("file \"{}\" can't opened", options.output->string()));
+            GenerateInput(ofs, options.day, *options.generate, options.seed.value_or(1u));
+            }
+         else GenerateInput(std::cout, options.day, *options.generate, options.seed.value_or(1u));
+         return 0;
+         }
+
+      if (options.batch) {
+         batch_options batch { .day = options.day, .part = options.part, .source = *options.batch, .jobs = options.jobs, .prefetch = options.prefetch };
+         batch_result result;
+         if (options.csv) {
+            std::ofstream ofs(*options.csv);
+            if (!ofs.is_open()) throw std::runtime_error(std::format("file \"{}\" can't opened", options.csv->string()));
+            result = RunBatch(batch, ofs);
+            }
+         else result = RunBatch(batch, std::cout);
+         std::clog << std::format("{} inputs for day {} / part {}, {} answered, {} failed in {:.3f} ms, sum of the riddles {:.3f} ms\n",
+                                  result.inputs, options.day, options.part, result.answered, result.failed,
+                                  result.wall.count() / 1'000'000.0, result.sum.count() / 1'000'000.0);
+         return result.failed == 0 ? 0 : 1;
+         }
+
+      if (!options.sweep.empty()) {
+         auto result = SweepRiddle(options.day, options.part, options.sweep, options.seed.value_or(1u),
+                                   options.benchmark.value_or(benchmark_options { .runs = 3, .warmup = 1 }));
+         WriteSweep(std::cout, result);
+         return 0;
+         }
+
+      const fs::path file_path = options.input ? *options.input : BuildInput(options.day, options.test, strApplication);
+
+      if (options.differential) {
+         auto result = DifferentialRiddle(options.day, options.part, file_path, options.benchmark.value_or(benchmark_options { .runs = 3, .warmup = 1 }));
+         WriteDifferential(std::cout, result);
+         return result.Passed() ? 0 : 1;
+         }
+
+      if (options.benchmark) {
+         auto result = BenchmarkRiddle(options.day, options.part, file_path, *options.benchmark);
+         WriteSummary(std::clog, result);
+         if (options.json) {
+            std::ofstream ofs(*options.json);
+            if (!ofs.is_open()) throw std::runtime_error(std::format("file \"{}\" can't opened", options.json->string()));
+            WriteJson(ofs, result);
+            }
+         else WriteJson(std::cout, result);
+         return 0;
+         }
+
+      std::cout << strThemes[0];
+      if (options.day < strThemes.size()) std::cout << " - " << strThemes[options.day];
+      std::cout << '\n';
+
+      TRiddleCancellation cancellation({ }, options.budget);
+      auto info = RunRiddle(options.day, options.part, file_path, options.verbose, run_options);
+      std::cout << Render(info.result);
+      std::cout.flush();
+
+      if (options.trace) {
+         std::ofstream ofs(*options.trace);
+         if (!ofs.is_open()) throw std::runtime_error(std::format("file \"{}\" can't opened", options.trace->string()));
+         WriteChromeTrace(ofs, info.result);
+         }
+
+      WriteFinished(std::clog, options.day, options.part, file_path, info);
+      return 0;
+      }
+   catch (my_riddle_cancelled const& ex) {
+      std::cerr << "day " << options.day << " / part " << options.part << ": " << ex.what() << '\n';
+      return 1;
+      }
+   catch (std::exception& ex) {
+      std::cerr << "error in console runner, message: " << ex.what() << '\n';
+      return 1;
+      }
+   }
@@ -0,0 +1,194 @@
+#include "AoC_Generator.h"
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <vector>
+#include <format>
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+
+namespace {
+
+   // day 1: calibration lines with letters and digits, digits as words for part 2, at least one digit
+   void GenerateDay1(std::ostream& out, size_t scale, TInputRandom& random) {
+      static constexpr std::array<std::string_view, 9> words = { "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+      for (size_t line = 0; line < scale; ++line) {
+         std::string strLine;
+         const auto iParts = random.Between(2, 8);
+         for (int64_t part = 0; part < iParts; ++part) {
+            switch (random.Next(3)) {
+               case 0:  strLine += random.Pick("123456789"); break;
+               case 1:  strLine += words[random.Next(words.size())]; break;
+               default: strLine += random.Pick("abcdefghijklmnopqrstuvwxyz"); break;
+               }
+            }
+         strLine.insert(random.Next(strLine.size() + 1), 1, random.Pick("123456789"));
+         out << strLine << '\n';
+         }
+      }
+
+   // day 2: games with draws of red, green and blue cubes
+   void GenerateDay2(std::ostream& out, size_t scale, TInputRandom& random) {
+      static constexpr std::array<std::string_view, 3> colors = { "red", "green", "blue" };
+      for (size_t game = 1; game <= scale; ++game) {
+         out << std::format("Game {}:", game);
+         const auto iDraws = random.Between(1, 6);
+         for (int64_t draw = 0; draw < iDraws; ++draw) {
+            auto order = colors;
+            random.Shuffle(order);
+            const auto iColors = random.Between(1, 3);
+            for (int64_t color = 0; color < iColors; ++color)
+               out << std::format("{} {} {}", color == 0 ? "" : ",", random.Between(1, 20), order[color]);
+            out << (draw + 1 < iDraws ? ";" : "");
+            }
+         out << '\n';
+         }
+      }
+
+   // day 3: square engine schematic with numbers, symbols and gears
+   void GenerateDay3(std::ostream& out, size_t scale, TInputRandom& random) {
+      for (size_t row = 0; row < scale; ++row) {
+         std::string strRow;
+         strRow.reserve(scale);
+         while (strRow.size() < scale) {
+            if (random.Chance(15)) {
+               const auto iDigits = std::min<size_t>(random.Between(1, 3), scale - strRow.size());
+               strRow += random.Pick("123456789");
+               for (size_t i = 1; i < iDigits; ++i) strRow += random.Pick("0123456789");
+               if (strRow.size() < scale) strRow += '.';
+               }
+            else strRow += random.Chance(8) ? random.Pick("*#+$/=%@&-") : '.';
+            }
+         out << strRow << '\n';
+         }
+      }
+
+   // day 4: scratchcards, mostly without matches, so the copies of part 2 don't grow exponential
+   void GenerateDay4(std::ostream& out, size_t scale, TInputRandom& random) {
+      for (size_t card = 1; card <= scale; ++card) {
+         std::vector<int> numbers(99);
+         std::iota(numbers.begin(), numbers.end(), 1);
+         random.Shuffle(numbers);
+         // the first 10 are the winning numbers, the own numbers are the next 25 with some of them
+         const auto iMatches = std::min<size_t>(random.Chance(75) ? 0 : random.Between(1, 3), scale - card);
+         std::vector<int> own(numbers.begin() + 10, numbers.begin() + 35);
+         std::copy_n(numbers.begin(), iMatches, own.begin());
+         random.Shuffle(own);
+
+         out << std::format("Card {:>3}:", card);
+         for (int i = 0; i < 10; ++i) out << std::format(" {:>2}", numbers[i]);
+         out << " |";
+         for (int value : own) out << std::format(" {:>2}", value);
+         out << '\n';
+         }
+      }
+
+   // day 7: camel cards with bids
+   void GenerateDay7(std::ostream& out, size_t scale, TInputRandom& random) {
+      for (size_t line = 0; line < scale; ++line) {
+         std::string strHand;
+         for (int i = 0; i < 5; ++i) strHand += random.Pick("AKQJT98765432");
+         out << strHand << ' ' << random.Between(1, 1000) << '\n';
+         }
+      }
+
+   // day 9: 21 values of polynomials up to the 4th degree with small coefficients
+   void GenerateDay9(std::ostream& out, size_t scale, TInputRandom& random) {
+      for (size_t line = 0; line < scale; ++line) {
+         std::array<int64_t, 5> coefficients { };
+         for (auto& coefficient : coefficients | std::views::take(random.Between(1, 5))) coefficient = random.Between(-9, 9);
+         for (int64_t x = 0; x < 21; ++x) {
+            int64_t value = 0;
+            for (auto coefficient : coefficients | std::views::reverse) value = value * x + coefficient;
+            out << (x > 0 ? " " : "") << value;
+            }
+         out << '\n';
+         }
+      }
+
+   // day 11: square universe with galaxies, every 10th row and column is empty and expands
+   void GenerateDay11(std::ostream& out, size_t scale, TInputRandom& random) {
+      std::vector<bool> empty_cols(scale);
+      for (size_t col = 0; col < scale; ++col) empty_cols[col] = random.Chance(10);
+      for (size_t row = 0; row < scale; ++row) {
+         std::string strRow(scale, '.');
+         if (!random.Chance(10))
+            for (size_t col = 0; col < scale; ++col)
+               if (!empty_cols[col] && random.Chance(2)) strRow[col] = '#';
+         out << strRow << '\n';
+         }
+      }
+
+   // day 13: patterns with a horizontal or vertical reflection, separated by empty lines
+   void GenerateDay13(std::ostream& out, size_t scale, TInputRandom& random) {
+      for (size_t pattern = 0; pattern < scale; ++pattern) {
+         const auto iWidth  = static_cast<size_t>(random.Between(5, 17));
+         const auto iHeight = static_cast<size_t>(random.Between(5, 17));
+         std::vector<std::string> rows(iHeight, std::string(iWidth, '.'));
+         for (auto& row : rows) for (auto& c : row) c = random.Pick(".#");
+
+         // mirror a part at a random line, horizontal or vertical
+         if (random.Chance(50)) {
+            const auto line = static_cast<size_t>(random.Between(1, iHeight - 1));
+            for (size_t i = 0; line + i < iHeight && i < line; ++i) rows[line + i] = rows[line - 1 - i];
+            }
+         else {
+            const auto line = static_cast<size_t>(random.Between(1, iWidth - 1));
+            for (auto& row : rows)
+               for (size_t i = 0; line + i < iWidth && i < line; ++i) row[line + i] = row[line - 1 - i];
+            }
+         if (pattern > 0) out << '\n';
+         for (auto const& row : rows) out << row << '\n';
+         }
+      }
+
+   // day 15: one line with steps of the initialization sequence
+   void GenerateDay15(std::ostream& out, size_t scale, TInputRandom& random) {
+      for (size_t step = 0; step < scale; ++step) {
+         if (step > 0) out << ',';
+         const auto iLength = random.Between(2, 6);
+         for (int64_t i = 0; i < iLength; ++i) out << random.Pick("abcdefghijklmnopqrstuvwxyz");
+         if (random.Chance(30)) out << '-';
+         else out << '=' << random.Between(1, 9);
+         }
+      out << '\n';
+      }
+
+   // day 16: square contraption with mirrors and splitters
+   void GenerateDay16(std::ostream& out, size_t scale, TInputRandom& random) {
+      for (size_t row = 0; row < scale; ++row) {
+         std::string strRow(scale, '.');
+         for (auto& c : strRow) if (random.Chance(10)) c = random.Pick("/\\|-");
+         out << strRow << '\n';
+         }
+      }
+
+   }
+
+std::map<int, input_generator> const& InputGenerators() {
+   static const std::map<int, input_generator> generators = {
+      {  1, { "lines",               GenerateDay1  } },
+      {  2, { "games",               GenerateDay2  } },
+      {  3, { "side of the grid",    GenerateDay3  } },
+      {  4, { "cards",               GenerateDay4  } },
+      {  7, { "hands",               GenerateDay7  } },
+      {  9, { "sequences",           GenerateDay9  } },
+      { 11, { "side of the grid",    GenerateDay11 } },
+      { 13, { "patterns",            GenerateDay13 } },
+      { 15, { "steps",               GenerateDay15 } },
+      { 16, { "side of the grid",    GenerateDay16 } }
+      };
+   return generators;
+   }
+
+void GenerateInput(std::ostream& out, int day, size_t scale, uint64_t seed) {
+   auto const& generators = InputGenerators();
+   auto it = generators.find(day);
+   if (it == generators.end()) throw std::invalid_argument(std::format("there is no generator for the input of day {}", day));
+   if (scale == 0) throw std::invalid_argument("the scale of a generated input must be at least 1");
+   TInputRandom random(seed);
+   it->second.generate(out, scale, random);
+   }
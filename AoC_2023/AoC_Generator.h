@@ -0,0 +1,46 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <functional>
+#include <random>
+#include <ranges>
+#include <string_view>
+#include <cstdint>
+
+/// deterministic random numbers for the generators, the same seed gives the same input with every
+/// standard library (only the engine is specified, not the distributions)
+class TInputRandom {
+   public:
+      TInputRandom(uint64_t seed) : theEngine(seed) { }
+
+      /// value in [0, bound)
+      uint64_t Next(uint64_t bound) { return bound > 0 ? theEngine() % bound : 0u; }
+      /// value in [first, last]
+      int64_t Between(int64_t first, int64_t last) { return first + static_cast<int64_t>(Next(static_cast<uint64_t>(last - first) + 1u)); }
+      /// true with the probability percent / 100
+      bool Chance(unsigned percent) { return Next(100u) < percent; }
+      /// one of the chars of the text
+      char Pick(std::string_view text) { return text[Next(text.size())]; }
+      /// Fisher-Yates, std::shuffle isn't the same with all standard libraries
+      template <std::ranges::random_access_range range_ty>
+      void Shuffle(range_ty&& values) {
+         for (auto i = std::ranges::size(values); i > 1; --i) std::ranges::swap(values[i - 1], values[Next(i)]);
+         }
+
+   private:
+      std::mt19937_64 theEngine;
+   };
+
+/// generator of a valid input for a day in any size
+struct input_generator {
+   std::string strScale;   ///< meaning of the scale, e.g. "lines" or "side of the grid"
+   std::function<void(std::ostream&, size_t, TInputRandom&)> generate;
+   };
+
+/// generators of the days with one, the days without are missing
+std::map<int, input_generator> const& InputGenerators();
+
+/// write the input of the day with the scale and the seed, throws std::invalid_argument for days without generator
+void GenerateInput(std::ostream& out, int day, size_t scale, uint64_t seed);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "aoc_lib.h"
+
 #include <vector>
 #include <stdexcept>
 #include <optional>
@@ -67,17 +69,17 @@ class TFixedMatrix {
       size_t Width() const { return iWidth; }  
       size_t Height(void) const { return iHeight; }
 
-      std::vector<positions_ty> GetCol(size_t x) const {
+      my_vector<positions_ty> GetCol(size_t x) const {
          if (!(x < iWidth)) throw std::runtime_error(std::format("the requested index for x = {0:} is out of range (0, {1:}) for this matrix ({1:}, {2:})", x, iWidth, iHeight));
          return std::views::iota(0ull, iHeight) | std::views::transform([x](auto y) { return positions_ty { x, y }; }) 
-                                             | std::ranges::to<std::vector>();
+                                             | std::ranges::to<my_vector<positions_ty>>();
          }
 
 
-      std::vector<positions_ty> GetRow(size_t y) const {
+      my_vector<positions_ty> GetRow(size_t y) const {
          if (!(y < iHeight)) throw std::runtime_error(std::format("the requested index for y = {0:} is out of range (0, {2:}) for this matrix ({1:}, {2:}) ", y, iWidth, iHeight));
          return std::views::iota(0ull, iWidth) | std::views::transform([y](auto x) { return positions_ty { x, y }; }) 
-                                            | std::ranges::to<std::vector>();
+                                            | std::ranges::to<my_vector<positions_ty>>();
          }
       
       void FillLine(size_t y, std::vector<Element_ty> values) {
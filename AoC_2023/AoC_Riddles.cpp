@@ -0,0 +1,165 @@
+#include "AoC_Riddles.h"
+
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <format>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std::placeholders;
+
+riddle_result help(int day, int part, my_lines file, bool) {
+   riddle_result result { .day = day, .part = part };
+   // unfortunately, there is no solution for this puzzle yet. perhaps the door was opened too early
+   // and we haven't reached the day yet. the result has no answer, only the size of the input
+   result.Counter("lines", file.size());
+   //QMessageBox::information(nullptr, strAoC.c_str(), QString::fromStdString(strMessage));
+   return result;
+   }
+
+std::vector<structure_data> advent_actions = {
+   { structure_data{ "btnDay01"s, 0, 0,  1, aoc2023_day1::Riddle  } },
+   { structure_data{ "btnDay02"s, 0, 1,  2, aoc2023_day2::Riddle  } },
+   { structure_data{ "btnDay03"s, 0, 2,  3, aoc2023_day3::Riddle  } },
+   { structure_data{ "btnDay04"s, 0, 3,  4, aoc2023_day4::Riddle  } },
+   { structure_data{ "btnDay05"s, 0, 4,  5, aoc2023_day5::Riddle  } },
+   { structure_data{ "btnDay06"s, 1, 0,  6, aoc2023_day6::Riddle  } },
+   { structure_data{ "btnDay07"s, 1, 1,  7, aoc2023_day7::Riddle  } },
+   { structure_data{ "btnDay08"s, 1, 2,  8, aoc2023_day8::Riddle  } },
+   { structure_data{ "btnDay09"s, 1, 3,  9, aoc2023_day9::Riddle  } },
+   { structure_data{ "btnDay10"s, 1, 4, 10, aoc2023_day10::Riddle } },
+   { structure_data{ "btnDay11"s, 2, 0, 11, aoc2023_day11::Riddle } },
+   { structure_data{ "btnDay12"s, 2, 1, 12, aoc2023_day12::Riddle } },
+   { structure_data{ "btnDay13"s, 2, 2, 13, aoc2023_day13::Riddle } },
+   { structure_data{ "btnDay14"s, 2, 3, 14, bind(help, 14, _1, _2, _3)  } },
+   { structure_data{ "btnDay15"s, 2, 4, 15, aoc2023_day15::Riddle } },
+   { structure_data{ "btnDay16"s, 3, 0, 16, aoc2023_day16::Riddle } },
+   { structure_data{ "btnDay17"s, 3, 1, 17, bind(help, 17, _1, _2, _3)  } },
+   { structure_data{ "btnDay18"s, 3, 2, 18, bind(help, 18, _1, _2, _3)  } },
+   { structure_data{ "btnDay19"s, 3, 3, 19, bind(help, 19, _1, _2, _3)  } },
+   { structure_data{ "btnDay20"s, 3, 4, 20, bind(help, 20, _1, _2, _3)  } },
+   { structure_data{ "btnDay21"s, 4, 0, 21, bind(help, 21, _1, _2, _3)  } },
+   { structure_data{ "btnDay22"s, 4, 1, 22, bind(help, 22, _1, _2, _3)  } },
+   { structure_data{ "btnDay23"s, 4, 2, 23, bind(help, 23, _1, _2, _3)  } },
+   { structure_data{ "btnDay24"s, 4, 3, 24, bind(help, 24, _1, _2, _3)  } },
+   { structure_data{ "btnDay25"s, 4, 4, 25, bind(help, 25, _1, _2, _3)  } }
+};
+
+const std::map<int, stream_func_ty> stream_actions = {
+   { 1, aoc2023_day1::StreamRiddle },
+   { 2, aoc2023_day2::StreamRiddle },
+   { 9, aoc2023_day9::StreamRiddle }
+};
+
+const std::multimap<int, std::pair<std::string, riddle_func_ty>> variant_actions = {
+   { 9, { "closed form"s, aoc2023_day9::FastRiddle } }
+};
+
+
+riddle_func_ty const& FindRiddle(int day) {
+   auto it = std::ranges::find_if(advent_actions, [day](auto const& data) { return std::get<3>(data) == day; });
+   if (it == advent_actions.end())
+      throw std::invalid_argument(std::format("there is no riddle for the day {}, expected values between 1 and 25", day));
+   return std::get<4>(*it);
+   }
+
+fs::path BuildInput(int day, bool test, std::string const& strApplication) {
+   // build the input file name from the day and part, selectively for test or production data
+   std::string strInput = std::format("../../../Input/{}/day{}.txt", (test ? "Test" : "Prod"), day);
+   fs::path executableDir = fs::path(strApplication).parent_path();
+   return fs::canonical(executableDir / fs::path(strInput));
+   }
+
+riddle_run_info RunRiddle(int day, int part, fs::path const& file_path, bool verbose, riddle_run_options const& options) {
+   auto const& func = FindRiddle(day);
+
+   riddle_run_info info;
+   // the counters are opened before, only the call of the riddle is counted
+   std::optional<TPerfCounters> perf;
+   if (options.hardware_counters) perf.emplace();
+
+   auto measure = [&perf, &info](auto&& call) {
+      if (perf) perf->Start();
+      auto func_start = std::chrono::steady_clock::now();
+      call();
+      auto func_ende = std::chrono::steady_clock::now();
+      if (perf) info.counters = perf->Stop();
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(func_ende - func_start);
+      };
+
+   // phases and counters of the riddle and of the tasks it started, handed to the result at the end
+   TPhaseRecorder recorder;
+   // opt-in, the global operator new counts only with a scope
+   my_allocation_stats allocations;
+   std::optional<TAllocationScope> allocation_scope;
+   if (options.count_allocations) allocation_scope.emplace(&allocations);
+   const auto memory_start = ProcessMemory();
+   // all allocations of the riddle come from one arena, released in one step at the end of the call
+   TRiddleArena arena(riddle_arena_options);
+
+   std::ostringstream strMode;
+   std::optional<uint64_t> cache_key;
+   if (auto stream_func = stream_actions.find(day);
+          stream_func != stream_actions.end() && fs::file_size(file_path) >= my_stream_lines::streaming_threshold) {
+      // too big to hold it complete, read the inputfile in blocks while the riddle processes it
+      my_stream_lines stream(file_path);
+      {
+      std::optional<TTraceSession> trace;
+      if (verbose) trace.emplace(std::cerr);
+      info.time = measure([&]() {
+         TPhaseTimer phase("solve");
+         info.result = stream_func->second(part, stream, verbose);
+         });
+      }
+      strMode << "streamed in " << stream.Blocks() << " blocks";
+      }
+   else {
+      // read associated inputfile, mapped for big files and buffered as fallback
+      std::optional<TInputSource> source;
+      {
+      TPhaseTimer phase("read");
+      source.emplace(file_path, EInputMode::automatic, my_mapping_options { .populate = true, .sequential = true });
+      }
+
+      // a stored answer is only used when nothing is measured and nothing is written, the measurements and
+      // the output of a verbose run need a real call
+      if (options.cache && !verbose && !options.count_allocations && !options.hardware_counters) {
+         cache_key = options.cache->Key(source->Content(), day, part);
+         if (auto cached = options.cache->Find(*cache_key); cached) {
+            info.result  = std::move(cached->result);
+            info.time    = cached->time;
+            info.strMode  = cached->strMode;
+            info.boCached = true;
+            return info;
+            }
+         }
+
+      // call function with the input in a my_lines container. the trace events refer to the input,
+      // the session ends and formats the rest before the source is released
+      {
+      std::optional<TTraceSession> trace;
+      if (verbose) trace.emplace(std::cerr);
+      info.time = measure([&]() {
+         TPhaseTimer phase("solve");
+         info.result = func(part, my_lines(source->Content()), verbose);
+         });
+      }
+      strMode << source->Mode();
+      }
+   if (arena.UsedHugePages()) strMode << ", huge pages";
+   recorder.MoveTo(info.result);
+   info.strMode = strMode.str();
+   if (cache_key) options.cache->Store(*cache_key, { .result = info.result, .time = info.time, .strMode = info.strMode });
+
+   allocation_scope.reset();
+   const auto memory_end = ProcessMemory();
+   info.memory = { .boAllocations = options.count_allocations,
+                   .allocations   = allocations.count.load(),
+                   .bytes         = allocations.bytes.load(),
+                   .peak_live     = static_cast<uint64_t>(std::max<int64_t>(0, allocations.peak.load())),
+                   .peak_rss      = memory_end.peak_rss,
+                   .minor_faults  = memory_end.minor_faults - memory_start.minor_faults,
+                   .major_faults  = memory_end.major_faults - memory_start.major_faults };
+   return info;
+   }
@@ -1,7 +1,14 @@
 #pragma once
 
+#include "aoc_lib.h"
+#include "AoC_Cache.h"
+
 #include <string>
 #include <vector>
+#include <map>
+#include <tuple>
+#include <chrono>
+#include <functional>
 #include <filesystem>
 
 using namespace std::literals::string_literals;
@@ -31,102 +38,154 @@ const std::vector<std::string> strThemes = {
 
 
 namespace aoc2023_day1 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
+   riddle_result StreamRiddle(int part, my_stream_lines& input, bool verbose);
 }
 
 namespace aoc2023_day2 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
+   riddle_result StreamRiddle(int part, my_stream_lines& input, bool verbose);
 }
 
 namespace aoc2023_day3 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day4 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 
 namespace aoc2023_day5 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
    }
 
 namespace aoc2023_day6 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
    }
 
 namespace aoc2023_day7 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
    }
 
 namespace aoc2023_day8 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
    }
 
 namespace aoc2023_day9 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
+   riddle_result FastRiddle(int part, my_lines input, bool verbose);
+   riddle_result StreamRiddle(int part, my_stream_lines& input, bool verbose);
 }
 
 namespace aoc2023_day10 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day11 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day12 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day13 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day14 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day15 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day16 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day17 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day18 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day19 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day20 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day21 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day22 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day23 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day24 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
 
 namespace aoc2023_day25 {
-   void Riddle(int part, my_lines input, bool verbose);
+   riddle_result Riddle(int part, my_lines input, bool verbose);
 }
+
+
+// --------------------------------------------------------------------
+// table of the riddles and the call of a riddle, shared by the user interface and the console runner
+// --------------------------------------------------------------------
+
+using riddle_func_ty  = std::function<riddle_result (int, my_lines, bool)>;
+using stream_func_ty  = std::function<riddle_result (int, my_stream_lines&, bool)>;
+/// name of the button, row and column in the calendar, day and the function for the riddle
+using structure_data  = std::tuple<std::string, int, int, int, riddle_func_ty>;
+
+extern std::vector<structure_data> advent_actions;
+/// riddles with independent lines, they can process big files as stream in blocks
+extern const std::map<int, stream_func_ty> stream_actions;
+
+/// further implementations of the riddles with their names, e.g. a rewrite for speed. the function in
+/// advent_actions stays the reference, a differential run compares the answers of the variants with it
+extern const std::multimap<int, std::pair<std::string, riddle_func_ty>> variant_actions;
+
+/// function of the riddle for the day, throws std::invalid_argument for unknown days
+riddle_func_ty const& FindRiddle(int day);
+
+/// path of the input file for a day, relative to the directory of the application
+fs::path BuildInput(int day, bool test, std::string const& strApplication);
+
+/// informations about a call of a riddle for the log
+struct riddle_run_info {
+   std::chrono::nanoseconds time;
+   std::string              strMode;
+   riddle_result            result;    ///< answer with the phases "read", "solve" and those of the riddle, Render() for the text
+   riddle_memory            memory;    ///< allocations only with count_allocations, MemoryText() for the log
+   std::optional<my_hardware_counters> counters;   ///< only with hardware_counters, HardwareCountersText() for the log
+   bool                     boCached = false;   ///< result and time of an earlier run from the cache, the riddle wasn't called
+   };
+
+/// optional measurements of RunRiddle
+struct riddle_run_options {
+   bool count_allocations = false;   ///< allocations of the riddle and its tasks, counted by the global operator new
+   bool hardware_counters = false;   ///< hardware counters around the call of the riddle, in the calling thread only
+   TResultCache const* cache = nullptr;   ///< answers of earlier runs, not used for streamed inputs, verbose and with measurements
+   };
+
+/// read the input file (mapped, buffered or as stream for big files) and call the riddle with an
+/// own memory arena. the time contains only the riddle, the trace events are drained at the end.
+/// nothing of the result is written, the caller renders it after the measurement. with a cache a known
+/// input returns the stored run without calling the riddle (boCached), the time is that of the stored run.
+/// a verbose call always solves, its output isn't stored
+riddle_run_info RunRiddle(int day, int part, fs::path const& file_path, bool verbose, riddle_run_options const& options = { });
@@ -0,0 +1,121 @@
+#include "AoC_RunAll.h"
+
+#include <fstream>
+#include <format>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+
+std::map<std::pair<int, int>, std::chrono::nanoseconds> ReadTimings(fs::path const& file_path) {
+   std::map<std::pair<int, int>, std::chrono::nanoseconds> timings;
+   if (file_path.empty() || !fs::exists(file_path)) return timings;
+
+   std::ifstream ifs(file_path);
+   if (!ifs.is_open()) throw std::runtime_error(std::format("file with timings \"{}\" can't opened", file_path.string()));
+   int day, part;
+   int64_t time;
+   while (ifs >> day >> part >> time) timings[{ day, part }] = std::chrono::nanoseconds { time };
+   return timings;
+   }
+
+void WriteTimings(fs::path const& file_path, run_all_result const& result) {
+   if (file_path.empty()) return;
+   // times of jobs which couldn't run this time are kept from the last run
+   auto timings = ReadTimings(file_path);
+   for (auto const& job : result.jobs)
+      if (job.strError.empty()) timings[{ job.day, job.part }] = job.info.time;
+
+   std::ofstream ofs(file_path);
+   if (!ofs.is_open()) throw std::runtime_error(std::format("file with timings \"{}\" can't opened", file_path.string()));
+   for (auto const& [key, time] : timings) ofs << key.first << ' ' << key.second << ' ' << time.count() << '\n';
+   }
+
+run_all_result RunAll(run_all_options const& options, std::string const& strApplication) {
+   run_all_result result;
+   const auto timings = ReadTimings(options.timings);
+
+   for (auto const& action : advent_actions) {
+      for (int part : { 1, 2 }) {
+         auto& job = result.jobs.emplace_back();
+         job.day  = std::get<3>(action);
+         job.part = part;
+         try {
+            job.input = BuildInput(job.day, options.test, strApplication);
+            }
+         catch (std::exception&) {
+            job.strError = "no input file";
+            }
+         if (auto it = timings.find({ job.day, job.part }); it != timings.end()) job.expected = it->second;
+         }
+      }
+
+   // longest first, so the total time is near to the longest job and not to the last one started
+   std::vector<run_all_job*> schedule;
+   for (auto& job : result.jobs)
+      if (job.strError.empty()) schedule.emplace_back(&job);
+   std::ranges::stable_sort(schedule, [](run_all_job const* lhs, run_all_job const* rhs) {
+      if (!lhs->expected || !rhs->expected) return !lhs->expected && rhs->expected;
+      return *lhs->expected > *rhs->expected;
+      });
+
+   // the jobs run in the pool of the process together with the parallel parts of the riddles, so there are
+   // never more busy threads than hardware threads. each of the 'jobs' runners takes the next job of the schedule
+   auto& pool = TThreadPool::Instance();
+   const size_t jobs = std::min(options.jobs > 0 ? options.jobs : pool.Concurrency(), schedule.size());
+   std::atomic<size_t> next = 0u;
+
+   TCaptureBuffer capture_out(std::cout, &my_captured_output::strOut);
+   TCaptureBuffer capture_err(std::cerr, &my_captured_output::strErr);
+   TCaptureBuffer capture_log(std::clog, &my_captured_output::strErr);
+
+   auto wall_start = std::chrono::steady_clock::now();
+   {
+   TTaskGroup group(pool);
+   for (size_t runner = 0; runner < jobs; ++runner) {
+      group.RunJob([&schedule, &next, &run_options = options.run]() {
+         for (size_t index; (index = next.fetch_add(1u, std::memory_order_relaxed)) < schedule.size(); ) {
+            auto job = schedule[index];
+            TOutputCapture capture(&job->output);
+            try {
+               job->info = RunRiddle(job->day, job->part, job->input, false, run_options);
+               }
+            catch (std::exception& ex) {
+               job->strError = ex.what();
+               }
+            }
+         });
+      }
+   group.Wait();
+   }
+   auto wall_ende = std::chrono::steady_clock::now();
+
+   result.wall = std::chrono::duration_cast<std::chrono::nanoseconds>(wall_ende - wall_start);
+   // the times from the cache weren't spent in this run
+   for (auto const& job : result.jobs)
+      if (!job.info.boCached) result.sum += job.info.time;
+   return result;
+   }
+
+void WriteRunAll(std::ostream& out, run_all_result const& result) {
+   size_t iFinished = 0;
+   for (auto const& job : result.jobs) {
+      out << std::format("--- day {} / part {} ", job.day, job.part);
+      if (!job.strError.empty() && job.input.empty()) {
+         out << std::format("skipped: {}\n", job.strError);
+         continue;
+         }
+      if (job.info.boCached) out << std::format("({}) from the cache, {:.3f} ms in an earlier run ---\n", job.info.strMode, job.info.time.count() / 1'000'000.0);
+      else out << std::format("({}) in {:.3f} ms ---\n", job.info.strMode, job.info.time.count() / 1'000'000.0);
+      out << Render(job.info.result);
+      // the allocations belong to the job, page faults and peak rss to the whole process
+      if (job.info.memory.boAllocations) out << "   memory: " << MemoryText(job.info.memory) << '\n';
+      if (job.info.counters) out << "   cpu: " << HardwareCountersText(*job.info.counters) << '\n';
+      out << job.output.strOut;
+      if (!job.output.strErr.empty()) out << job.output.strErr;
+      if (!job.strError.empty()) out << "error: " << job.strError << '\n';
+      else ++iFinished;
+      }
+   out << std::format("\n{} riddles finished in {:.3f} ms, sum of the riddles {:.3f} ms\n", iFinished,
+                      result.wall.count() / 1'000'000.0, result.sum.count() / 1'000'000.0);
+   }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "aoc_lib.h"
+#include "AoC_Riddles.h"
+
+#include <iostream>
+#include <string>
+#include <deque>
+#include <chrono>
+#include <optional>
+#include <filesystem>
+
+/// settings to run all riddles at once
+struct run_all_options {
+   bool               test = false;   ///< test inputs instead of the production inputs
+   size_t             jobs = 0;       ///< riddles running at the same time, 0 = threads of the pool
+   riddle_run_options run;            ///< measurements for each job
+   fs::path           timings;        ///< times of earlier runs for the order of the jobs, updated after the run, empty = none
+   };
+
+/// one day and part of the run, the output is collected and written after all jobs are finished
+struct run_all_job {
+   int                                     day  = 0;
+   int                                     part = 0;
+   fs::path                                input;
+   std::optional<std::chrono::nanoseconds> expected;   ///< time of the last run from the timings file
+   riddle_run_info                         info;
+   my_captured_output                      output;
+   std::string                             strError;   ///< exception of the riddle or missing input
+   };
+
+/// result of all jobs in order of day and part
+struct run_all_result {
+   std::deque<run_all_job>  jobs;       ///< deque, the jobs can't be moved with their output
+   std::chrono::nanoseconds wall { 0 }; ///< time from the start of the first to the end of the last job
+   std::chrono::nanoseconds sum  { 0 }; ///< sum of the times of all riddles
+   };
+
+/// times of earlier runs, lines with "day part nanoseconds". a missing file is no error
+std::map<std::pair<int, int>, std::chrono::nanoseconds> ReadTimings(fs::path const& file_path);
+void WriteTimings(fs::path const& file_path, run_all_result const& result);
+
+/// run every day and part concurrently in the thread pool of the process, the longest jobs of the last
+/// run first and jobs without time before them. std::cout and std::cerr are captured for each job
+run_all_result RunAll(run_all_options const& options, std::string const& strApplication);
+
+/// output of all jobs in order of day and part, followed by a summary
+void WriteRunAll(std::ostream& out, run_all_result const& result);
@@ -3,15 +3,19 @@
 #include <QTextEdit>
 #include <QLabel>
 #include <QString>
+#include <QMetaObject>
 
 #include <iostream>
 #include <sstream>
+#include <mutex>
 
 
 
+/// the riddles run in a worker thread, the derived classes hand the text to the thread of their widget
 class StreamBufBase : public std::streambuf {
 protected:
    std::stringstream os;
+   std::mutex        mutex;
 public:
    StreamBufBase(void) : std::streambuf() { };
    virtual ~StreamBufBase(void) { };
@@ -19,6 +23,7 @@ public:
    virtual void Write(void) = 0;
 
    virtual int_type overflow(int_type c) override {
+      std::scoped_lock lock(mutex);
       switch (c) {
          case '\n':
             Write();
@@ -43,14 +48,16 @@ class MemoStreamBuf : public StreamBufBase {
       virtual ~MemoStreamBuf(void) { value = nullptr; }
 
       virtual void Write(void) override {
-         if (this->os.str().length() > 0) [[likely]] {
-            value->moveCursor(QTextCursor::End);
-            value->insertPlainText(QString::fromStdString(os.str()));
-            value->insertPlainText("\n");
-            }
-         else {
-            value->append("");
-            }
+         QMetaObject::invokeMethod(value, [edit = value, text = QString::fromStdString(os.str())]() {
+            if (text.length() > 0) [[likely]] {
+               edit->moveCursor(QTextCursor::End);
+               edit->insertPlainText(text);
+               edit->insertPlainText("\n");
+               }
+            else {
+               edit->append("");
+               }
+            }, Qt::AutoConnection);
          }
    };
 
@@ -68,7 +75,9 @@ class LabelStreamBuf : public StreamBufBase {
       virtual ~LabelStreamBuf(void) { value = nullptr; }
 
       virtual void Write(void) override {
-         value->setText(QString::fromStdString(os.str()));
+         QMetaObject::invokeMethod(value, [label = value, text = QString::fromStdString(os.str())]() {
+            label->setText(text);
+            }, Qt::AutoConnection);
          }
    };
 
@@ -110,6 +119,7 @@ public:
 class WStreamBufBase : public std::wstreambuf {
 protected:
    std::wstringstream os;
+   std::mutex         mutex;
 public:
    WStreamBufBase(void) : std::wstreambuf() { };
    virtual ~WStreamBufBase(void) { };
@@ -117,6 +127,7 @@ public:
    virtual void Write(void) = 0;
 
    virtual int_type overflow(int_type c) override {
+      std::scoped_lock lock(mutex);
       switch (c) {
       case L'\n':
          Write();
@@ -141,14 +152,16 @@ public:
    virtual ~WMemoStreamBuf(void) { value = nullptr; }
 
    virtual void Write(void) override {
-      if (this->os.str().length() > 0) [[likely]] {
-         value->moveCursor(QTextCursor::End);
-         value->insertPlainText(QString::fromStdWString(os.str()));
-         value->insertPlainText(QString("\n"));
+      QMetaObject::invokeMethod(value, [edit = value, text = QString::fromStdWString(os.str())]() {
+         if (text.length() > 0) [[likely]] {
+            edit->moveCursor(QTextCursor::End);
+            edit->insertPlainText(text);
+            edit->insertPlainText(QString("\n"));
+            }
+         else {
+            edit->append(QString(""));
          }
-      else {
-         value->append(QString(""));
-      }
+      }, Qt::AutoConnection);
    }
 };
 
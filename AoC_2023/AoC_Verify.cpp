@@ -0,0 +1,131 @@
+#include "AoC_Verify.h"
+
+#include <fstream>
+#include <sstream>
+#include <format>
+#include <algorithm>
+#include <stdexcept>
+
+std::vector<verify_entry> ReadManifest(fs::path const& file_path) {
+   std::ifstream ifs(file_path);
+   if (!ifs.is_open()) throw std::runtime_error(std::format("manifest \"{}\" can't opened", file_path.string()));
+
+   std::vector<verify_entry> entries;
+   std::string strLine;
+   for (size_t iLine = 1; std::getline(ifs, strLine); ++iLine) {
+      if (auto pos = strLine.find('#'); pos != std::string::npos) strLine.erase(pos);
+      std::istringstream line(strLine);
+      std::string strInput;
+      if (!(line >> strInput)) continue;
+
+      verify_entry entry;
+      if (strInput != "test" && strInput != "prod")
+         throw std::runtime_error(std::format("manifest line {}: expected test or prod, not \"{}\"", iLine, strInput));
+      entry.test = strInput == "test";
+      if (!(line >> entry.day >> entry.part >> entry.answer))
+         throw std::runtime_error(std::format("manifest line {}: expected day, part and answer", iLine));
+      for (std::string strBudget; line >> strBudget; ) {
+         if (strBudget.starts_with("time="))        entry.time   = std::chrono::milliseconds(toInt<int64_t>(std::string_view(strBudget).substr(5)));
+         else if (strBudget.starts_with("memory=")) entry.memory = toInt<uint64_t>(std::string_view(strBudget).substr(7)) * 1024u;
+         else throw std::runtime_error(std::format("manifest line {}: unknown budget \"{}\"", iLine, strBudget));
+         }
+      entries.emplace_back(std::move(entry));
+      }
+   return entries;
+   }
+
+void WriteManifest(fs::path const& file_path, std::vector<verify_entry> const& entries) {
+   std::ofstream ofs(file_path);
+   if (!ofs.is_open()) throw std::runtime_error(std::format("manifest \"{}\" can't opened", file_path.string()));
+   ofs << "# expected answers of the riddles for AoC_Console --verify, recorded with --record\n"
+       << "# test|prod <day> <part> <answer> [time=<ms>] [memory=<KiB>]\n";
+   for (auto const& entry : entries) {
+      ofs << std::format("{} {} {} {}", entry.test ? "test" : "prod", entry.day, entry.part, entry.answer);
+      if (entry.time)   ofs << std::format(" time={}", entry.time->count());
+      if (entry.memory) ofs << std::format(" memory={}", (*entry.memory + 1023u) / 1024u);
+      ofs << '\n';
+      }
+   }
+
+std::vector<verify_job> VerifyRiddles(std::vector<verify_entry> const& entries, std::string const& strApplication) {
+   std::vector<verify_job> jobs;
+   for (auto const& entry : entries) {
+      auto& job = jobs.emplace_back(verify_job { .entry = entry });
+      try {
+         const auto file_path = BuildInput(entry.day, entry.test, strApplication);
+         // a riddle far over its budget is cancelled, when it polls the cancellation
+         TRiddleCancellation cancellation({ }, entry.time ? std::optional(*entry.time * 2) : std::nullopt);
+         job.info = RunRiddle(entry.day, entry.part, file_path, false, { .count_allocations = entry.memory.has_value() });
+
+         if (auto strAnswer = AnswerText(job.info.result); strAnswer != entry.answer)
+            job.strError = std::format("answer {} instead of {}", job.info.result.HasAnswer() ? strAnswer : "missing"s, entry.answer);
+         else if (entry.time && job.info.time > *entry.time)
+            job.strError = std::format("{:.3f} ms over the time budget of {} ms", job.info.time.count() / 1'000'000.0, entry.time->count());
+         else if (entry.memory && job.info.memory.peak_live > *entry.memory)
+            job.strError = std::format("peak of {} KiB over the memory budget of {} KiB", job.info.memory.peak_live / 1024u, *entry.memory / 1024u);
+         }
+      catch (my_riddle_cancelled const& ex) {
+         job.strError = ex.what();
+         }
+      catch (std::exception& ex) {
+         job.strError = ex.what();
+         }
+      }
+   return jobs;
+   }
+
+std::vector<verify_entry> RecordRiddles(std::vector<verify_entry> const& old_entries, std::string const& strApplication) {
+   std::vector<verify_entry> entries;
+   for (bool test : { true, false }) {
+      for (auto const& action : advent_actions) {
+         const int day = std::get<3>(action);
+         fs::path file_path;
+         try {
+            file_path = BuildInput(day, test, strApplication);
+            }
+         catch (std::exception&) {
+            continue;   // no input for the day
+            }
+         for (int part : { 1, 2 }) {
+            riddle_run_info info;
+            try {
+               info = RunRiddle(day, part, file_path, false, { .count_allocations = true });
+               }
+            catch (std::exception& ex) {
+               std::cerr << std::format("day {} / part {} not recorded: {}\n", day, part, ex.what());
+               continue;
+               }
+            if (!info.result.HasAnswer()) continue;   // not solved yet
+
+            verify_entry entry { .test = test, .day = day, .part = part, .answer = AnswerText(info.result) };
+            auto old = std::ranges::find_if(old_entries, [&entry](verify_entry const& e) {
+               return e.test == entry.test && e.day == entry.day && e.part == entry.part;
+               });
+            if (old != old_entries.end()) {
+               entry.time   = old->time;
+               entry.memory = old->memory;
+               }
+            else {
+               entry.time   = std::max(std::chrono::milliseconds(100), std::chrono::ceil<std::chrono::milliseconds>(info.time * 3));
+               entry.memory = std::max<uint64_t>(1024u * 1024u, info.memory.peak_live * 3);
+               }
+            entries.emplace_back(std::move(entry));
+            }
+         }
+      }
+   return entries;
+   }
+
+size_t WriteVerify(std::ostream& out, std::vector<verify_job> const& jobs) {
+   size_t iFailed = 0;
+   for (auto const& job : jobs) {
+      out << std::format("{} day {} / part {}: ", job.entry.test ? "test" : "prod", job.entry.day, job.entry.part);
+      if (job.strError.empty()) out << std::format("ok in {:.3f} ms\n", job.info.time.count() / 1'000'000.0);
+      else {
+         out << "FAILED, " << job.strError << '\n';
+         ++iFailed;
+         }
+      }
+   out << std::format("\n{} of {} riddles passed\n", jobs.size() - iFailed, jobs.size());
+   return iFailed;
+   }
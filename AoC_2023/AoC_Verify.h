@@ -0,0 +1,42 @@
+#pragma once
+
+#include "aoc_lib.h"
+#include "AoC_Riddles.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <optional>
+#include <filesystem>
+
+/// expected answer and budgets for a day and part with the test or production input of BuildInput
+struct verify_entry {
+   bool                                     test = false;
+   int                                      day  = 0;
+   int                                      part = 0;
+   std::string                              answer;   ///< like AnswerText() of the result
+   std::optional<std::chrono::milliseconds> time;     ///< budget for the solver, the riddle is cancelled after it
+   std::optional<uint64_t>                  memory;   ///< budget for the peak of live bytes, counted allocations
+   };
+
+/// lines "test|prod <day> <part> <answer> [time=<ms>] [memory=<KiB>]", # starts a comment
+std::vector<verify_entry> ReadManifest(fs::path const& file_path);
+void WriteManifest(fs::path const& file_path, std::vector<verify_entry> const& entries);
+
+/// result of one entry, an empty strError means passed
+struct verify_job {
+   verify_entry    entry;
+   riddle_run_info info;
+   std::string     strError;
+   };
+
+/// run every entry of the manifest one after the other, so the times aren't disturbed by other riddles
+std::vector<verify_job> VerifyRiddles(std::vector<verify_entry> const& entries, std::string const& strApplication);
+
+/// run every day and part with an existing input and an answer and build the entries for the manifest.
+/// budgets of the old entries are kept, new entries get a budget of 3 times the time and memory now
+std::vector<verify_entry> RecordRiddles(std::vector<verify_entry> const& old_entries, std::string const& strApplication);
+
+/// a line for each job and a summary, returns the count of failed jobs
+size_t WriteVerify(std::ostream& out, std::vector<verify_job> const& jobs);
@@ -0,0 +1,167 @@
+#include "AoC_Watch.h"
+
+#include <iostream>
+#include <format>
+#include <stdexcept>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
+#include <charconv>
+
+#if defined(__linux__)
+   #include <sys/inotify.h>
+   #include <poll.h>
+   #include <unistd.h>
+#endif
+
+std::optional<watched_input> WatchedInput(fs::path const& file_path) {
+   const auto strName = file_path.filename().string();
+   const auto strKind = file_path.parent_path().filename().string();
+   if (!strName.starts_with("day") || !strName.ends_with(".txt") || (strKind != "Test" && strKind != "Prod")) return { };
+
+   int day = 0;
+   const auto first = strName.data() + 3, last = strName.data() + strName.size() - 4;
+   if (auto [ptr, ec] = std::from_chars(first, last, day); ec != std::errc { } || ptr != last || day < 1 || day > 25) return { };
+   return watched_input { .day = day, .test = strKind == "Test" };
+   }
+
+TInputWatcher::TInputWatcher(fs::path const& directory, callback_ty callback, std::chrono::milliseconds debounce) :
+         theCallback(std::move(callback)), theDebounce(debounce) {
+   if (!fs::is_directory(directory)) throw std::runtime_error(std::format("directory \"{}\" to watch doesn't exist", directory.string()));
+   theDirectory = fs::canonical(directory);
+
+   #if defined(__linux__)
+      iNotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (iNotify >= 0 && !AddWatch(theDirectory)) {
+         // e.g. fs.inotify.max_user_watches exceeded, the intervals are the fallback
+         ::close(iNotify);
+         iNotify = -1;
+         theWatches.clear();
+         }
+   #endif
+   boPolling = iNotify < 0;
+   theThread = std::jthread([this](std::stop_token token) {
+      if (boPolling) Poll(token);
+      else Notify(token);
+      });
+   }
+
+TInputWatcher::~TInputWatcher() {
+   // the thread reads the descriptor, it's closed after the join
+   theThread.request_stop();
+   if (theThread.joinable()) theThread.join();
+   #if defined(__linux__)
+      if (iNotify >= 0) ::close(iNotify);
+   #endif
+   }
+
+bool TInputWatcher::AddWatch(fs::path const& directory) {
+   #if defined(__linux__)
+      int wd = ::inotify_add_watch(iNotify, directory.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+      if (wd < 0) return false;
+      theWatches[wd] = directory;
+      std::error_code ec;
+      for (auto const& entry : fs::directory_iterator(directory, fs::directory_options::skip_permission_denied, ec))
+         if (entry.is_directory(ec) && !AddWatch(entry.path())) return false;
+      return true;
+   #else
+      return false;
+   #endif
+   }
+
+void TInputWatcher::Changed(fs::path const& file_path) {
+   thePending[file_path] = clock_ty::now();
+   }
+
+void TInputWatcher::Deliver() {
+   const auto now = clock_ty::now();
+   std::vector<fs::path> files;
+   for (auto it = thePending.begin(); it != thePending.end(); ) {
+      if (now - it->second < theDebounce) ++it;
+      else {
+         files.emplace_back(it->first);
+         it = thePending.erase(it);
+         }
+      }
+   if (files.empty()) return;
+
+   // the watcher continues after an error of the callback
+   try {
+      theCallback(files);
+      }
+   catch (std::exception& ex) {
+      std::cerr << "watch of \"" << theDirectory.string() << "\": " << ex.what() << '\n';
+      }
+   }
+
+void TInputWatcher::Notify(std::stop_token token) {
+   #if defined(__linux__)
+      alignas(inotify_event) char buffer[16 * 1024];
+      while (!token.stop_requested()) {
+         // short timeouts while changes wait for the debounce, so they are delivered in time
+         pollfd descriptor { .fd = iNotify, .events = POLLIN, .revents = 0 };
+         if (::poll(&descriptor, 1, thePending.empty() ? 100 : 20) > 0) {
+            for (ssize_t size; (size = ::read(iNotify, buffer, sizeof(buffer))) > 0; ) {
+               for (char* ptr = buffer; ptr < buffer + size; ) {
+                  auto const* event = reinterpret_cast<inotify_event const*>(ptr);
+                  ptr += sizeof(inotify_event) + event->len;
+                  if (event->mask & IN_IGNORED) {
+                     theWatches.erase(event->wd);
+                     continue;
+                     }
+                  auto watch = theWatches.find(event->wd);
+                  if (watch == theWatches.end() || event->len == 0) continue;
+
+                  auto file_path = watch->second / event->name;
+                  if (event->mask & IN_ISDIR) {
+                     // new directories are watched too, files copied into them before are found with them
+                     if (AddWatch(file_path)) {
+                        std::error_code ec;
+                        for (auto const& entry : fs::recursive_directory_iterator(file_path, fs::directory_options::skip_permission_denied, ec))
+                           if (entry.is_regular_file(ec)) Changed(entry.path());
+                        }
+                     }
+                  else Changed(file_path);
+                  }
+               }
+            }
+         Deliver();
+         }
+   #else
+      Poll(token);
+   #endif
+   }
+
+TInputWatcher::snapshot_ty TInputWatcher::Snapshot() const {
+   snapshot_ty files;
+   std::error_code ec;
+   for (auto const& entry : fs::recursive_directory_iterator(theDirectory, fs::directory_options::skip_permission_denied, ec)) {
+      std::error_code file_ec;
+      if (!entry.is_regular_file(file_ec)) continue;
+      auto time = entry.last_write_time(file_ec);
+      auto size = entry.file_size(file_ec);
+      if (!file_ec) files.emplace(entry.path(), std::make_pair(time, size));
+      }
+   return files;
+   }
+
+void TInputWatcher::Poll(std::stop_token token) {
+   const auto interval = std::max(theDebounce, std::chrono::milliseconds(100));
+   std::mutex mutex;
+   std::condition_variable_any wakeup;
+   auto files = Snapshot();
+   while (!token.stop_requested()) {
+      {
+      std::unique_lock lock(mutex);
+      wakeup.wait_for(lock, token, interval, []() { return false; });
+      }
+      if (token.stop_requested()) break;
+      auto current = Snapshot();
+      for (auto const& [file_path, state] : current)
+         if (auto old = files.find(file_path); old == files.end() || old->second != state) Changed(file_path);
+      files = std::move(current);
+      // a file is quiet when it's unchanged in the next interval
+      Deliver();
+      }
+   }
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <optional>
+#include <functional>
+#include <filesystem>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+/// input file of a day, Input/Test/dayN.txt or Input/Prod/dayN.txt
+struct watched_input {
+   int  day  = 0;
+   bool test = false;
+   };
+
+/// day and kind of the input for a changed file, empty for all other files
+std::optional<watched_input> WatchedInput(fs::path const& file_path);
+
+/// watches the files of a directory tree and reports the changed files, when they are quiet for the debounce
+/// time. editors write a file in several steps (truncate, write, rename), the callback sees it only once.
+/// linux uses inotify, the other systems and a failed inotify compare the write times of the files in
+/// intervals. the callback is called in the thread of the watcher, implemented in AoC_Watch.cpp
+class TInputWatcher {
+   public:
+      using callback_ty = std::function<void (std::vector<fs::path> const&)>;
+
+      TInputWatcher(fs::path const& directory, callback_ty callback,
+                    std::chrono::milliseconds debounce = std::chrono::milliseconds(150));
+      TInputWatcher(TInputWatcher const&) = delete;
+      TInputWatcher& operator = (TInputWatcher const&) = delete;
+      ~TInputWatcher();
+
+      fs::path const& Directory() const { return theDirectory; }
+      /// true when the files are compared in intervals, without notifications of the system
+      bool Polling() const { return boPolling; }
+
+   private:
+      using clock_ty = std::chrono::steady_clock;
+      using snapshot_ty = std::map<fs::path, std::pair<fs::file_time_type, uintmax_t>>;
+
+      /// inotify watch for the directory and its subdirectories, false when the system refused one
+      bool AddWatch(fs::path const& directory);
+      void Notify(std::stop_token token);
+      void Poll(std::stop_token token);
+      /// changed file, reported when there is no change for the debounce time
+      void Changed(fs::path const& file_path);
+      /// call the callback with the quiet files
+      void Deliver();
+      snapshot_ty Snapshot() const;
+
+      fs::path                                 theDirectory;
+      callback_ty                              theCallback;
+      std::chrono::milliseconds                theDebounce;
+      std::map<fs::path, clock_ty::time_point> thePending;        ///< only used in the thread of the watcher
+      std::map<int, fs::path>                  theWatches;        ///< inotify watch descriptors and their directories
+      int                                      iNotify = -1;
+      bool                                     boPolling = true;
+      std::jthread                             theThread;   ///< last member
+   };
@@ -48,15 +48,14 @@ std::string replaceText(std::string_view input, number_as_text_ty const& replace
    }
 
 
-template <EPart_of_Riddle part>
-void Solution(my_lines input, bool verbose) {
-   std::cout << part << ".\n";
-
+/// the lines are independent, the input is a my_lines or for big files a my_stream_lines
+template <EPart_of_Riddle part, typename input_ty>
+riddle_result Solution(input_ty& input, bool verbose) {
+   riddle_result result { .day = 1, .part = part, .strLabel = "sum of all of the calibration values = {}" };
    try {
-      int sum = 0;
-      size_t cnt = 0;
-      
-      for (auto const& value : input) {
+      size_t cnt = 0;   // only used for verbose output, this runs in one chunk
+
+      auto calibration = [&cnt, verbose](int64_t& sum, std::string_view value) {
          auto row = [&]() {
                            if constexpr (part == EPart_of_Riddle::Part1) return value;
                            else if (part == EPart_of_Riddle::Part2) return replaceText(value, number_as_text);
@@ -67,26 +66,37 @@ void Solution(my_lines input, bool verbose) {
             auto pos = std::make_pair(row.find_first_of(strNumbers1), row.find_last_of(strNumbers2));
             if (pos.first == std::string::npos || pos.second == std::string::npos)
                throw std::runtime_error("unexpected input in row ["s + std::string(row.data(), row.size()) + "]"s);
-            ++cnt;
 
-            auto value = 10 * (row[pos.first] - '0') + row[pos.second] - '0';
-            sum += value;
-            if(verbose) std::cerr << std::setw(4) << cnt << ": " << row << " -> " << value << '\n';
+            auto number = 10 * (row[pos.first] - '0') + row[pos.second] - '0';
+            sum += number;
+            // the line of the input, the replaced text of part 2 is released with the call
+            if(verbose) TraceEvent<"{:4}: {} -> {}\n">(++cnt, value, number);
             }
-         }
-      std::cout << "sum of all of the calibration values = " << sum << '\n';
+         };
+
+      // streamed inputs with millions of lines leave the range of int
+      int64_t sum = input.map_reduce(int64_t { 0 }, calibration, my_add_to{}, verbose ? 1 : 0);
+      result.Answer(sum);
       }
    catch (std::exception& ex) {
       std::cerr << "error in program for day 1, " << ex.what() << '\n';
       }
+   return result;
    }
 
 
-void Riddle(int part, my_lines input, bool verbose) {
-   std::cout << "1st Day, ";
+riddle_result Riddle(int part, my_lines input, bool verbose) {
+   switch(part) {
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
+      default: throw std::runtime_error("unexpexted part for the riddle at 1st day.");
+      }
+   }
+
+riddle_result StreamRiddle(int part, my_stream_lines& input, bool verbose) {
    switch(part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 1st day.");
       }
    }
@@ -1,5 +1,4 @@
 ﻿#include "aoc_lib.h"
-#include "aoc_wcout.h"
 
 #include <iostream>
 #include <map>
@@ -8,11 +7,11 @@
 #include <span>
 //#include <mdspan>
 #include <utility>
+#include <string_view>
 #include <stdexcept>
 #include <ranges>
 #include <format>
 #include <algorithm>
-#include <QCoreApplication>
 
 namespace aoc2023_day10 {
 
@@ -192,6 +191,17 @@ namespace aoc2023_day10 {
 
          size_t Width() const { return iWidth; }
          size_t Height() const { return iHeight; } 
+
+         /// the landscape as trace events, one for each tile
+         void TraceMap() const {
+            for (size_t i = 0; auto const& c : data) {
+               TraceEvent<"{}">(static_cast<char>(std::get<0>(c)));
+               if (!(++i < iWidth)) {
+                  TraceEvent<"\n">();
+                  i = 0;
+                  }
+               }
+            }
          positions_ty const& GetStart() const { return theStartPos; }
          KindOfPipe KindofStart() const { return std::get<0>((*this)[theStartPos]); }
 
@@ -392,9 +402,10 @@ namespace aoc2023_day10 {
                return lhs;
             }
 
-         static TLandscape CreateData(std::vector<std::string_view> const& input) {
+         static TLandscape CreateData(my_lines const& input) {
             TLandscape ret;
-            ret.iWidth = input.begin()->size();
+            if (input.size() == 0) throw std::runtime_error("input is empty, expected the lines of the landscape");
+            ret.iWidth = input[0].size();
             ret.iHeight = input.size();
             ret.data.reserve(ret.iWidth * ret.iHeight);
             
@@ -473,16 +484,20 @@ namespace aoc2023_day10 {
       }
 
 
-   inline std::ostream& operator << (std::ostream& out, TLandscape::Directions data) {
+   /// name of the direction, a literal, so trace events can refer to it
+   inline std::string_view DirectionText(TLandscape::Directions data) {
       switch (data) {
-      case TLandscape::Directions::undefined: out << "undefined"; break;
-      case TLandscape::Directions::east:      out << "eastward";  break;
-      case TLandscape::Directions::north:     out << "northward"; break;
-      case TLandscape::Directions::west:      out << "westward";  break;
-      case TLandscape::Directions::south:     out << "southward"; break;
+      case TLandscape::Directions::undefined: return "undefined";
+      case TLandscape::Directions::east:      return "eastward";
+      case TLandscape::Directions::north:     return "northward";
+      case TLandscape::Directions::west:      return "westward";
+      case TLandscape::Directions::south:     return "southward";
       default: throw std::runtime_error("unexpected direction");
       }
-      return out;
+      }
+
+   inline std::ostream& operator << (std::ostream& out, TLandscape::Directions data) {
+      return out << DirectionText(data);
       }
 
    inline std::wostream& operator << (std::wostream& out, TLandscape::Directions data) {
@@ -497,15 +512,19 @@ namespace aoc2023_day10 {
          return out;
       }
 
-   inline std::ostream& operator << (std::ostream& out, TLandscape::Moves data) {
+   /// name of the move, a literal, so trace events can refer to it
+   inline std::string_view MoveText(TLandscape::Moves data) {
       switch(data) {
-         case TLandscape::Moves::undefined: out << "undefined"; break;
-         case TLandscape::Moves::straight:  out << "forward"; break;
-         case TLandscape::Moves::right:     out << "right turn"; break;
-         case TLandscape::Moves::left:      out << "left turn"; break;
+         case TLandscape::Moves::undefined: return "undefined";
+         case TLandscape::Moves::straight:  return "forward";
+         case TLandscape::Moves::right:     return "right turn";
+         case TLandscape::Moves::left:      return "left turn";
          default: throw std::runtime_error("unexpected move in output");
          }
-      return out;
+      }
+
+   inline std::ostream& operator << (std::ostream& out, TLandscape::Moves data) {
+      return out << MoveText(data);
       }
 
    inline std::wostream& operator << (std::wostream& out, TLandscape::Moves data) {
@@ -574,21 +593,18 @@ namespace aoc2023_day10 {
 
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
-      std::cout << part << ".\n";
-
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 10, .part = part };
       try {
 
-         auto input_vec = input | std::views::transform([](auto p) { return std::string_view{ p }; }) | std::ranges::to<std::vector>();
-         auto test = TLandscape::CreateData(input_vec);
+         auto test = TLandscape::CreateData(input);
          auto step = test.FirstMove(test.GetStart());
 
          if(verbose) {
-            std::cerr << "\nStart at " << test.GetStart() << " with kind " << test.KindofStart() 
-                      << " in direction " << std::get<0>(step) << " / " << std::get<1>(step) << '\n';
-
-            TWout_Wrapper w(std::wcerr);
-            std::wcerr << L'\n' << test << L"\n\n";
+            TraceEvent<"\nStart at ({}, {}) with kind {}">(test.GetStart().first, test.GetStart().second, static_cast<char>(test.KindofStart()));
+            TraceEvent<" in direction {} / {}\n\n">(DirectionText(std::get<0>(step)), MoveText(std::get<1>(step)));
+            test.TraceMap();
+            TraceEvent<"\n">();
             }
 
          std::vector<TLandscape::route_ty> data;
@@ -596,35 +612,41 @@ namespace aoc2023_day10 {
          std::copy(view.cbegin(), view.cend(), std::back_inserter(data));
 
          if(verbose) {
-            std::cerr << "\nlist with all pipe parts:\n";
+            TraceEvent<"\nlist with all pipe parts:\n">();
             for(auto const& pos : data) {
-               std::cerr << std::get<0>(pos) << " " << std::get<2>(pos) << " " << std::get<1>(pos) << " " << std::get<3>(pos) << '\n';
-               Processing_Events();
+               TraceEvent<"({}, {}) {} ">(std::get<0>(pos).first, std::get<0>(pos).second, static_cast<char>(std::get<2>(pos)));
+               TraceEvent<"{} {}\n">(DirectionText(std::get<1>(pos)), MoveText(std::get<3>(pos)));
                }
             }
 
-         std::cout << "Part1: The opposite side is in " << data.size() / 2 << " steps.\n";
-
          auto target = TLandscape::CreateData(test.Width(), test.Height(), data);
-         std::cout << "Part2: There are " << target.FloodFill() << " closed areas in the landscape.\n";
+         if constexpr (part == EPart_of_Riddle::Part1) {
+            result.strLabel = "The opposite side is in {} steps.";
+            result.Answer(data.size() / 2);
+            }
+         else {
+            result.strLabel = "There are {} closed areas in the landscape.";
+            result.Answer(target.FloodFill());
+            }
 
          if(verbose) {
-            TWout_Wrapper w(std::wcerr); // attention, this wrapper connect TextEdit memOutput
-            std::wcerr << L'\n' << target << L"\n\n";
+            TraceEvent<"\n">();
+            target.TraceMap();
+            TraceEvent<"\n">();
          }
    
          }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 10, " << part << ": " << ex.what() << '\n';
       }
+      return result;
    }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "10th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 8th day.");
       }
    }
@@ -18,9 +18,10 @@ namespace aoc2023_day11 {
       private:
  
 
-         using row_data      = std::vector<SpaceElements>;
-         using galaxies_data = std::vector<row_data>;
-         using expanding_ty  = std::vector<size_t>;
+         // all containers are allocated in the arena of the riddle (RiddleResource)
+         using row_data      = my_vector<SpaceElements>;
+         using galaxies_data = my_vector<row_data>;
+         using expanding_ty  = my_vector<size_t>;
 
          size_t iWidth  = 0;
          size_t iHeight = 0;
@@ -34,8 +35,9 @@ namespace aoc2023_day11 {
          TIntergalacticSpace() = delete;
          TIntergalacticSpace(TIntergalacticSpace const&) = delete;
 
-         TIntergalacticSpace(std::vector<std::string_view> const& input) {
-            iWidth = input.begin()->size();
+         TIntergalacticSpace(my_lines const& input) {
+            if (input.size() == 0) throw std::runtime_error("input is empty, expected the lines of the image");
+            iWidth = input[0].size();
             iHeight = input.size();
             data.resize(iHeight);
             for (size_t i = 0; auto const& line : input) {
@@ -69,7 +71,7 @@ namespace aoc2023_day11 {
                                   std::views::filter([this](auto const& idx) {
                                           return std::all_of(this->data.begin(), this->data.end(), [this, idx](auto row) {
                                                      return row[idx] == SpaceElements::empty; });
-                                          }) | std::ranges::to<std::vector>();
+                                          }) | std::ranges::to<expanding_ty>();
 
             std::ranges::sort(emptycols, [](auto lhs, auto rhs) { return lhs > rhs; });
                
@@ -83,7 +85,7 @@ namespace aoc2023_day11 {
                                                               return e == SpaceElements::empty; }); 
                                        })
                                   | std::views::transform([](auto p) { return std::get<0>(p); })
-                                  | std::ranges::to<std::vector>();
+                                  | std::ranges::to<expanding_ty>();
 
             std::ranges::sort(emptyrows, [](auto lhs, auto rhs) { return lhs > rhs; });
             for (auto i : emptyrows)  {
@@ -92,7 +94,7 @@ namespace aoc2023_day11 {
                }
             }
 
-         std::vector<position_ty> Scan() {
+         my_vector<position_ty> Scan() {
             auto range_cols = std::views::iota(0, static_cast<int>(iWidth));
             auto range_rows = std::views::iota(0, static_cast<int>(iHeight));
 
@@ -102,21 +104,21 @@ namespace aoc2023_day11 {
                                        | std::views::filter([this](auto const& p) -> bool {
                                            position_ty pos { std::get<0>(p), std::get<1>(p) };
                                            return (*this)[pos] == SpaceElements::galaxy; })
-                                       | std::ranges::to<std::vector>();
+                                       | std::ranges::to<my_vector<position_ty>>();
  
             return coordinates;
             }
 
          // lower triangular matrix
-         static std::vector<std::pair<position_ty, position_ty>> Combine(std::vector<position_ty> const& values) {
+         static my_vector<std::pair<position_ty, position_ty>> Combine(my_vector<position_ty> const& values) {
             auto lower_triangle = std::views::iota(0ull, values.size())
                                          | std::views::transform([&values](auto i) {
                                                    return  std::views::iota(i + 1u, values.size())
                                                                | std::views::transform([i, &values](size_t j) {
                                                                         return std::make_pair(values[i], values[j]); })
-                                                               | std::ranges::to<std::vector>(); })
+                                                               | std::ranges::to<my_vector<std::pair<position_ty, position_ty>>>(); })
                                          | std::views::join
-                                         | std::ranges::to<std::vector>();
+                                         | std::ranges::to<my_vector<std::pair<position_ty, position_ty>>>();
             return lower_triangle;
             }
 
@@ -141,12 +143,12 @@ namespace aoc2023_day11 {
             return sum += Distance(val);
             }
 
-         void Print(std::ostream& out) {
+         /// the image as trace events, one for each element
+         void TraceMap() const {
             for(auto const& row : data) {
-               for (auto pos : row) out << static_cast<char>(pos);
-               out << '\n';
+               for (auto pos : row) TraceEvent<"{}">(static_cast<char>(pos));
+               TraceEvent<"\n">();
                }
-
             }
 
       };
@@ -162,40 +164,42 @@ namespace aoc2023_day11 {
 
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
-      std::cout << part << ".\n";
-
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 11, .part = part, .strLabel = "distance of all galaxies to others is {}" };
       try {
-         auto input_vec = input | std::views::transform([](auto p) { return std::string_view{ p }; }) | std::ranges::to<std::vector>();
-         TIntergalacticSpace space(input_vec);
-         if(verbose) space.Print(std::cerr);
+         TIntergalacticSpace space = [&input]() { TPhaseTimer phase("parse"); return TIntergalacticSpace(input); }();
+         if(verbose) space.TraceMap();
          //space.Expand();
          if(verbose) {
-            std::cerr << "\n-----------------\n";
-            space.Print(std::cerr);
+            TraceEvent<"\n-----------------\n">();
+            space.TraceMap();
             }
-         auto positions = space.Scan();
+         auto positions = [&space]() { TPhaseTimer phase("scan"); return space.Scan(); }();
          if(verbose) {
-            std::cerr << "galaxies at positions:\n";
-            for (auto const& pos : positions) std::cerr << pos << '\n';
+            TraceEvent<"galaxies at positions:\n">();
+            for (auto const& pos : positions) TraceEvent<"({}, {})\n">(pos.first, pos.second);
             }
-         auto pairs = TIntergalacticSpace::Combine(positions);
+         auto pairs = [&positions]() { TPhaseTimer phase("combine"); return TIntergalacticSpace::Combine(positions); }();
 
-         auto solution = std::accumulate(pairs.begin(), pairs.end(), 0ull, std::bind(&TIntergalacticSpace::Distance_Sum, &space, _1, _2));
+         // the distances are independent, summed up in the thread pool
+         TPhaseTimer phase("distances");
+         auto solution = TThreadPool::Instance().parallel_reduce(0u, pairs.size(), 0ull, [&space, &pairs](unsigned long long& sum, size_t idx) {
+                                                                     sum += space.Distance(pairs[idx]); });
 
-         std::cout << "distance of all galaxies to others is " << solution << '\n';
+         result.Counter("galaxies", positions.size());
+         result.Answer(solution);
       }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 11, " << part << ": " << ex.what() << '\n';
       }
+      return result;
    }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "11th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 8th day.");
       }
    }
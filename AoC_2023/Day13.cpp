@@ -144,8 +144,8 @@ namespace aoc2023_day13 {
 
 
 
-            void Read(std::vector<std::string_view> const& input) {
-               iWidth = input.begin()->size();
+            void Read(my_block const& input) {
+               iWidth = input.front().size();
                iHeight = input.size();         
                data.reserve(iWidth * iHeight);
                for (size_t i; auto const& line : input) {
@@ -176,11 +176,11 @@ namespace aoc2023_day13 {
 
          if (horizontal && !vertical) {
             sum += *horizontal; 
-            if(verbose) data.PrintScan(EDirection::vertical, *horizontal, std::cerr);
+            if(verbose) data.PrintScan(EDirection::vertical, *horizontal, TOutputCapture::Err());
             }
          else if(vertical && !horizontal) {
             sum += 100 * *vertical; // std::cout << "vertical at " << *test << '\n';
-            if (verbose) data.PrintScan(EDirection::horizontal, *vertical, std::cerr);
+            if (verbose) data.PrintScan(EDirection::horizontal, *vertical, TOutputCapture::Err());
             }
          else if(vertical && horizontal) {
             if (verbose) {
@@ -200,7 +200,7 @@ namespace aoc2023_day13 {
          return sum;
          }
 
-      TLandScape(std::vector<std::string_view> const& input) { // , std::vector<std::string_view> const& input_2) {
+      TLandScape(my_block const& input) { // , std::vector<std::string_view> const& input_2) {
          data.Read(input);
          //data2.Read(input_2);
          }
@@ -208,40 +208,36 @@ namespace aoc2023_day13 {
 
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
-      std::cout << part << ".\n";
-
-      auto input_vec = input | std::views::transform([](auto p) { return std::string_view{ p }; }) | std::ranges::to<std::vector>();
-      auto blocks = input_vec | std::views::transform([](auto p) { return std::string_view{ p }; }) 
-                              | std::views::split(std::string_view{}) | std::ranges::to<std::vector>();
-
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 13, .part = part };
 
       //std::ranges::for_each(blocks | std::views::chunk(2), [](auto subrange) {
       //TLandScape test({ subrange[0].begin(), subrange[0].end() }, { subrange[1].begin(), subrange[1].end() });
-      size_t solution = 0;
-      std::ranges::for_each(blocks, [&solution, verbose](auto subrange) {
-          TLandScape test({ subrange.begin(), subrange.end() });
+      // the landscapes are independent, every block is scanned as task in the thread pool
+      auto blocks = input.blocks();
+      size_t solution = TThreadPool::Instance().parallel_reduce(0u, blocks.size(), size_t { 0 }, [&blocks, verbose](size_t& sum, size_t idx) {
+          TLandScape test(blocks[idx]);
           //test.Print(std::cerr);
-          solution += test.Scan(verbose);
-          });
+          sum += test.Scan(verbose);
+          }, my_add_to{}, verbose ? 1 : 0);
  
 
       try {
-         std::cout << "solution = " << solution << '\n';
-
+         result.Counter("patterns", blocks.size());
+         result.Answer(solution);
       }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 13, " << part << ": " << ex.what() << '\n';
       }
+      return result;
    }
 
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "13th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 8th day.");
       }
    }
@@ -7,23 +7,22 @@
 namespace aoc2023_day14 {
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
-      std::cout << part << ".\n";
-
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 14, .part = part };
       try {
-         std::cout << "solution = " << '\n';
+         // not solved yet, the result has no answer
       }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 14, " << part << ": " << ex.what() << '\n';
       }
+      return result;
    }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "14th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 8th day.");
       }
    }
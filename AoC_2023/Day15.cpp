@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <stdexcept>
 #include <ranges>
 #include <algorithm>
@@ -10,16 +11,20 @@
 namespace aoc2023_day15 {
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
-
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 15, .part = part };
       try {
+         if (input.size() == 0) throw std::runtime_error("input is empty, expected the sequence in the first line");
          std::string_view view = *input.begin();
          std::string text = to_String(view);
+         std::vector<std::string> seq;
+         // the events refer to text and the strings of seq, formatted before they are released, also with an error
+         TTraceFlush flush(verbose);
          text.erase(std::remove(text.begin(), text.end(), ' '), text.end());
          text.erase(std::remove(text.begin(), text.end(), '\n'), text.end());
-         if (verbose) std::cerr << text << '\n';
+         if (verbose) TraceEvent<"{}\n">(std::string_view { text });
 
-         auto seq = text | std::views::split(',')
+         seq = text | std::views::split(',')
             | std::views::transform([](auto v) { return std::string{ v.begin(), v.end() }; })
             | std::ranges::to<std::vector>();
 
@@ -30,26 +35,23 @@ namespace aoc2023_day15 {
                sum = sum % 256;
                return sum;
                });
-            if (verbose) std::cerr << "Seq=" << p << " hash= " << val << '\n';
+            if (verbose) TraceEvent<"Seq={} hash= {}\n">(std::string_view { p }, val);
             return sum += val;
             });
-         std::cerr << sum << "\n";
-         std::cerr << part << ".\n";
-
-
-         std::cout << "solution = " << sum << '\n';
+         result.Counter("steps", seq.size());
+         result.Answer(sum);
       }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 15, " << part << ": " << ex.what() << '\n';
       }
+      return result;
    }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "15th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 8th day.");
       }
    }
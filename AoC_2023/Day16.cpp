@@ -158,17 +158,21 @@ namespace aoc2023_day16 {
       };
 
       MyMatrix::TFixedMatrix<kind_of_contraption> data;
-      std::vector<TBeam> beams;
-      std::vector<TBeam> new_beams;
+      my_vector<TBeam> beams;
+      my_vector<TBeam> new_beams;
 
    public:
       TLavaContraption() = default;
 
       void run() {
          size_t count = 0;
+         auto& progress = RiddleProgress();
+         uint64_t iStates = 0;
+         int64_t iSpawned = 0;
          while(beams.size() > 0 ) { //}&& ++count < 1000) {
             std::erase_if(beams, [](auto const& e) { return !e.Running(); } );
             if(new_beams.size() > 0) {
+               iSpawned += new_beams.size();
                std::ranges::copy(new_beams, std::back_inserter(beams));
                new_beams.clear();
                }
@@ -176,10 +180,14 @@ namespace aoc2023_day16 {
                bool cont;
                do {
                   cont = beam.Move();
+                  ++iStates;
                   } 
                while (cont);
                }
+            progress.States(iStates);
             }
+         PhaseCounter("beams spawned", iSpawned);
+         PhaseCounter("moves", iStates);
          }
 
       void start() {
@@ -195,30 +203,31 @@ namespace aoc2023_day16 {
       std::pair<EPieces, MyMatrix::positions_ty> Hit(MyMatrix::positions_ty pos, EMotion step_motion) {
          if(!(pos.first < data.Width() && pos.second < data.Height())) return { EPieces::out_of_map, pos };
            
-         auto space = [&]() -> std::vector<MyMatrix::positions_ty> {
+         // the temporary rows and columns are short living, the pool of the riddle arena reuses them
+         auto space = [&]() -> my_vector<MyMatrix::positions_ty> {
                           switch(step_motion) {
                              case EMotion::rightward:
                                 return data.GetRow(pos.second) 
                                    | std::views::filter([&pos](auto const& p) { return p.first >= pos.first; })
                                    | std::views::transform([](auto p) { return MyMatrix::positions_ty{ p }; } )
-                                   | std::ranges::to<std::vector>();
+                                   | std::ranges::to<my_vector<MyMatrix::positions_ty>>();
                              case EMotion::leftward:
                                 return data.GetRow(pos.second) 
                                    | std::views::filter([&pos](auto const& p) { return p.first <= pos.first; })
                                    | std::views::reverse
                                    | std::views::transform([](auto p) { return MyMatrix::positions_ty{ p }; })
-                                   | std::ranges::to<std::vector>();
+                                   | std::ranges::to<my_vector<MyMatrix::positions_ty>>();
                              case EMotion::downward:
                                 return data.GetCol(pos.first)
                                    | std::views::filter([&pos](auto const& p) { return p.second >= pos.second; })
                                    | std::views::transform([](auto p) { return MyMatrix::positions_ty{ p }; })
-                                   | std::ranges::to<std::vector>();
+                                   | std::ranges::to<my_vector<MyMatrix::positions_ty>>();
                              case EMotion::upward:
                                 return data.GetCol(pos.first)
                                    | std::views::filter([&pos](auto const& p) { return p.second <= pos.second; })
                                    | std::views::reverse
                                    | std::views::transform([](auto p) { return MyMatrix::positions_ty{ p }; })
-                                   | std::ranges::to<std::vector>();
+                                   | std::ranges::to<my_vector<MyMatrix::positions_ty>>();
                              default: return { };
                              }
                        }();
@@ -280,17 +289,19 @@ namespace aoc2023_day16 {
          return { piece, pos };
          }
 
-      void PrintEnergy(std::ostream& out) const {
+      /// energized tiles as trace events, one event for every tile
+      void TraceEnergy() const {
          for(size_t y = 0; y < data.Height();++y) {
-            for (auto const& pos : data.GetRow(y)) out << (std::get<1>(data[pos]) > 0 ? '#' : ' ');
-            out << '\n';
+            for (auto const& pos : data.GetRow(y)) TraceEvent<"{}">(std::get<1>(data[pos]) > 0 ? '#' : ' ');
+            TraceEvent<"\n">();
             }
          }
 
-      void PrintMap(std::ostream& out) const {
+      /// contraption as trace events, one event for every tile
+      void TraceMap() const {
          for (size_t y = 0; y < data.Height(); ++y) {
-            for (auto const& pos : data.GetRow(y)) out << static_cast<char>(std::get<0>(data[pos]));
-            out << '\n';
+            for (auto const& pos : data.GetRow(y)) TraceEvent<"{}">(static_cast<char>(std::get<0>(data[pos])));
+            TraceEvent<"\n">();
             }
          }
 
@@ -302,8 +313,8 @@ namespace aoc2023_day16 {
          }
 
       void Read(my_lines input) {
-         auto input_vec = input | std::views::transform([](auto p) { return std::string_view{ p }; }) | std::ranges::to<std::vector>();
-         data = MyMatrix::TFixedMatrix<kind_of_contraption>::CreateMatrix(input_vec.begin()->size(), input_vec.size(), { EPieces::empty, 0 });
+         if (input.size() == 0) throw std::runtime_error("input is empty, expected the lines of the contraption");
+         data = MyMatrix::TFixedMatrix<kind_of_contraption>::CreateMatrix(input[0].size(), input.size(), { EPieces::empty, 0 });
          for (size_t i = 0; auto const& line : input) {
             if (line.size() != data.Width()) throw std::runtime_error(std::format("unexpected input size in line {}, size is {}, expected was {}", i, line.size(), data.Width()));
             std::vector<kind_of_contraption> values(data.Width());
@@ -315,29 +326,35 @@ namespace aoc2023_day16 {
       
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
-      std::cout << part << ".\n";
-
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 16, .part = part };
       try {
          TLavaContraption data;
+         {
+         TPhaseTimer phase("parse");
          data.Read(input);
-         data.PrintMap(std::cout);
+         }
+         if (verbose) data.TraceMap();
+         {
+         TPhaseTimer phase("run");
          data.start();
          data.run();
-         data.PrintEnergy(std::cerr);
-         std::cout << "solution = " << data.count() << '\n';
+         }
+         if (verbose) data.TraceEnergy();
+         TPhaseTimer phase("count");
+         result.Answer(data.count());
       }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 16, " << part << ": " << ex.what() << '\n';
       }
+      return result;
    }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "16th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 8th day.");
       }
    }
@@ -45,55 +45,45 @@ namespace aoc2023_day2 {
                                                             {"blue"sv, EColors::blue},
                                                             {"green"sv, EColors::green} };
 
-      size_t pos1 = str.find_first_of(strNumbers1);
-      size_t pos2 = str.find_first_not_of(strNumbers2, pos1);
-      if (pos1 == std::string_view::npos || pos2 == std::string_view::npos || pos1 >= pos2) {
-         std::runtime_error(std::format("couldn't read draw with numbers in: {}", str));
-         }
-      int iCount = toInt<unsigned short>(str.substr(pos1, pos2 - pos1));
-      pos1 = str.find_first_not_of(" ", pos2);
-      auto text = str.substr(pos1, str.size() - pos1);
-      if(auto it = bridge.find(text); it != bridge.end()) {
+      static constexpr my_pattern<" {count:uint} {color} "> dice_pattern;
+
+      auto dice = dice_pattern.match(str);
+      if (!dice) throw std::runtime_error(std::format("couldn't read draw with numbers in: {}", str));
+      auto iCount = static_cast<unsigned short>(dice_pattern.get<"count">(*dice));
+      if(auto it = bridge.find(dice_pattern.get<"color">(*dice)); it != bridge.end()) {
          draw[it->second] += iCount;
          }
       // std::cerr << std::format(" --> {} = {}\n", text, iCount);
       }
 
-template <EPart_of_Riddle part>
-void Solution(my_lines input, bool verbose) {
-
-   std::cout << part << '\n';
+/// the games are independent, the input is a my_lines or for big files a my_stream_lines
+template <EPart_of_Riddle part, typename input_ty>
+riddle_result Solution(input_ty& input, bool verbose) {
 
-   auto lines = input | std::views::transform([](auto p) { return std::string_view{ p }; }) | std::ranges::to<std::vector>();
-   
-   if(verbose) std::cerr << lines.size() << " rows readed and will processed now.\n";
+   if constexpr (std::ranges::sized_range<input_ty>)
+      if(verbose) TraceEvent<"{} rows readed and will processed now.\n">(input.size());
 
-   uint32_t check_sum = 0;
-   
-   for(auto const& line : lines) {
-      if(verbose) std::cerr << std::format("process line: {}\n", line);
+   auto game = [verbose](uint64_t& check_sum, std::string_view line) {
+      if (verbose) TraceEvent<"process line: {}\n">(line);
 
       std::conditional_t<part == EPart_of_Riddle::Part2, dices_with_colors, bool > check_value;
       if constexpr (part == EPart_of_Riddle::Part1) check_value = true;
 
       // read the game in the line
-      size_t pos1 = line.find_first_of(strNumbers1);
-      size_t pos2 = line.find_first_not_of(strNumbers2, pos1);
-      if(pos1 == std::string_view::npos || pos2 == std::string_view::npos || pos1 >= pos2) {
-         std::runtime_error(std::format("couldn't read game id in input line: {}", line));
-         }
-      auto iGame = toInt<int>(line.substr(pos1, pos2 - pos1));
-
-      if (verbose) std::cerr << std::format("Game ID = {}\n",iGame);
-      pos1 = line.find_first_not_of(" ", line.find(':') + 1);
-      std::string_view draws_input = trim(line.substr(pos1, line.size() - pos1));
-      if (verbose) std::cerr << std::format("Game data: {}\n", draws_input);
+      static constexpr my_pattern<"Game {id:uint}: {draws} "> game_pattern;
+      auto parsed = game_pattern.match(line);
+      if (!parsed) throw std::runtime_error(std::format("couldn't read game id in input line: {}", line));
+      auto iGame = static_cast<int>(game_pattern.get<"id">(*parsed));
+
+      if (verbose) TraceEvent<"Game ID = {}\n">(iGame);
+      std::string_view draws_input = game_pattern.get<"draws">(*parsed);
+      if (verbose) TraceEvent<"Game data: {}\n">(draws_input);
       
       auto draws = draws_input | std::views::split(';') | std::views::transform([](auto d) { return trim(std::string_view { d.begin(), d.end() }); })
                                | std::ranges::to<std::vector>();
 
       for (auto const& draw : draws) {
-         if (verbose) std::cerr << std::format("draw: {}\n",draw);
+         if (verbose) TraceEvent<"draw: {}\n">(draw);
          dices_with_colors draw_to_check;
 
          auto dices = draw 
@@ -103,7 +93,7 @@ void Solution(my_lines input, bool verbose) {
 
 
          for(auto const& dice : dices | std::views::transform([](auto d) { return trim(d); })) {
-            if (verbose) std::cerr << std::format("dice: {} read as |", dice);
+            if (verbose) TraceEvent<"dice: {} read as |">(dice);
             Add(draw_to_check, dice);
             }
 
@@ -124,19 +114,31 @@ void Solution(my_lines input, bool verbose) {
          }
       else {
          auto values = check_value | std::views::transform([](auto p) { return p.second;  }) | std::ranges::to<std::vector>();
-         check_sum += std::reduce(values.begin(), values.end(), 1, std::multiplies<>());
+         check_sum += std::reduce(values.begin(), values.end(), uint64_t { 1 }, std::multiplies<>());
 
          }
-      }
+      };
 
-   std::cout << "the solution for " << part << " is " << check_sum << ".\n";
+   // streamed inputs with hundred thousands of games leave the range of uint32_t
+   uint64_t check_sum = input.map_reduce(uint64_t { 0 }, game, my_add_to{}, verbose ? 1 : 0);
+
+   riddle_result result { .day = 2, .part = part, .strLabel = "the solution is {}." };
+   result.Answer(check_sum);
+   return result;
+   }
+
+riddle_result Riddle(int part, my_lines input, bool verbose) {
+      switch (part) {
+         case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+         case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
+         default: throw std::runtime_error("unexpexted part for the riddle at 2nd day.");
+         }
    }
 
-void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "2nd Day, ";
+riddle_result StreamRiddle(int part, my_stream_lines& input, bool verbose) {
       switch (part) {
-         case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-         case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+         case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+         case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
          default: throw std::runtime_error("unexpexted part for the riddle at 2nd day.");
          }
    }
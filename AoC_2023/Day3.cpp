@@ -9,15 +9,14 @@
 namespace aoc2023_day3 {
 
 
-   void Solution1(my_lines input, bool verbose) {
-      std::cout << EPart_of_Riddle::Part1 << '\n';
+   riddle_result Solution1(my_lines input, bool verbose) {
+      riddle_result result { .day = 3, .part = EPart_of_Riddle::Part1 };
 
-      auto data = input | std::views::transform([](auto p) { return std::string_view{ p }; })
-         | std::ranges::to<std::vector>();
-      if(verbose) std::cerr << std::format("{} lines readed.\n", data.size());
+      auto const& data = input;
+      if (verbose) TraceEvent<"{} lines readed.\n">(data.size());
       int check_sum = 0;
       for (size_t i = 0; i < data.size(); ++i) {
-         if (verbose) std::cerr << std::format("{}\n", data[i]);
+         if (verbose) TraceEvent<"{}\n">(data[i]);
          for(auto pos1 = data[i].find_first_of(strNumbers1); pos1 != std::string_view::npos; pos1 = data[i].find_first_of(strNumbers1, pos1)) {
             size_t pos2 = data[i].find_first_not_of(strNumbers2, pos1);
             if (pos2 == std::string_view::npos) pos2 = data[i].size() - 1;
@@ -44,7 +43,7 @@ namespace aoc2023_day3 {
 
          end:
             auto value = toInt<int>(data[i].substr(pos1, pos2 - pos1));
-            if (verbose) std::cerr << std::format("{} {}\n", value, check);
+            if (verbose) TraceEvent<"{} {}\n">(value, check);
             if (check) {
                check_sum += value;
                }
@@ -52,14 +51,14 @@ namespace aoc2023_day3 {
             }
 
          }
-      std::cout << check_sum << '\n';
+      result.Answer(check_sum);
+      return result;
       }
 
-   void Solution2(my_lines input, bool verbose) {
-       std::cout << EPart_of_Riddle::Part2 << '\n';
+   riddle_result Solution2(my_lines input, bool verbose) {
+      riddle_result result { .day = 3, .part = EPart_of_Riddle::Part2 };
 
-      auto data = input | std::views::transform([](auto p) { return std::string_view{ p }; })
-                        | std::ranges::to<std::vector>();
+      auto const& data = input;
 
       auto findnumber = [&data](size_t line, size_t col) {
          size_t start = col, end = col;
@@ -68,13 +67,13 @@ namespace aoc2023_day3 {
          return toInt<int>(data[line].substr(start, end - start + 1));
          };
 
-      std::cout << std::format("{} lines readed.\n", data.size());
+      result.Counter("lines", data.size());
       uint64_t check_sum = 0;
       for (size_t i = 0; i < data.size(); ++i) {
          //if (verbose) (std::format("{}\n", data[i]);
          for (auto pos1 = data[i].find_first_of("*"); pos1 != std::string_view::npos; pos1 = data[i].find_first_of("*", pos1)) {
             std::pair<size_t, size_t> pos = { pos1 > 0 ? pos1 - 1 : 0, pos1 + 1 < data[i].size() ? pos1 + 1 : pos1 };
-            if (verbose) std::cerr << std::format("Line {}, Col {} -> ({}, {})", i, pos1, pos.first, pos.second);
+            if (verbose) TraceEvent<"Line {}, Col {} -> ({}, {})">(i, pos1, pos.first, pos.second);
             uint32_t gear_ratio = 1;
             int iFound = 0;
             if(i > 0) {
@@ -82,13 +81,13 @@ namespace aoc2023_day3 {
                   // possible 2 values in a line
                   if(pos1 > 0 && isdigit(data[i - 1][pos1 - 1])) {
                      auto val = findnumber(i - 1, pos1 - 1);
-                     if (verbose) std::cerr << std::format(" ^- {}", val);
+                     if (verbose) TraceEvent<" ^- {}">(val);
                      gear_ratio *= val;
                      ++iFound;
                      }
                   if (pos1 + 1 < data[i - 1].size() && isdigit(data[i - 1][pos1 + 1])) {
                      auto val = findnumber(i - 1, pos1 + 1);
-                     if (verbose) std::cerr << std::format(" -^ {}", val);
+                     if (verbose) TraceEvent<" -^ {}">(val);
                      gear_ratio *= val;
                      ++iFound;
                      }
@@ -97,7 +96,7 @@ namespace aoc2023_day3 {
                   for(size_t j = pos.first; j < pos.second + 1;++j) { 
                      if(isdigit(data[i-1][j])) {
                         auto val = findnumber(i - 1, j);
-                        if (verbose) std::cerr << std::format(" ^ {}", val);
+                        if (verbose) TraceEvent<" ^ {}">(val);
                         gear_ratio *= val;
                         ++iFound;
                         break;
@@ -108,14 +107,14 @@ namespace aoc2023_day3 {
 
             if(pos1 > 0 && isdigit(data[i][pos1 - 1])) {
                auto val = findnumber(i, pos1 - 1);
-               if (verbose) std::cerr << std::format(" < {}", val);
+               if (verbose) TraceEvent<" < {}">(val);
                gear_ratio *= val;
                ++iFound;
                }
 
             if (pos1 + 1 < data[i].size() && isdigit(data[i][pos1 + 1])) {
                auto val = findnumber(i, pos1 + 1);
-               if (verbose) std::cerr << std::format(" > {}", val);
+               if (verbose) TraceEvent<" > {}">(val);
                gear_ratio *= val;
                ++iFound;
                }
@@ -125,13 +124,13 @@ namespace aoc2023_day3 {
                   // possible 2 values in a line
                   if (pos1 > 0 && isdigit(data[i + 1][pos1 - 1])) {
                      auto val = findnumber(i + 1, pos1 - 1);
-                     if (verbose) std::cerr << std::format(" v- {}", val);
+                     if (verbose) TraceEvent<" v- {}">(val);
                      gear_ratio *= val;
                      ++iFound;
                      }
                   if (pos1 + 1 < data[i + 1].size() && isdigit(data[i + 1][pos1 + 1])) {
                      auto val = findnumber(i + 1, pos1 + 1);
-                     if (verbose) std::cerr << std::format(" -v {}", val);
+                     if (verbose) TraceEvent<" -v {}">(val);
                      gear_ratio *= val;
                      ++iFound;
                      }
@@ -140,7 +139,7 @@ namespace aoc2023_day3 {
                   for (size_t j = pos.first; j < pos.second + 1; ++j) {
                      if (isdigit(data[i + 1][j])) {
                         auto val = findnumber(i + 1, j);
-                        if(verbose) std::cerr << std::format(" v {}", val);
+                        if (verbose) TraceEvent<" v {}">(val);
                         gear_ratio *= val;
                         ++iFound;
                         break;
@@ -150,26 +149,26 @@ namespace aoc2023_day3 {
                }
 
             if (iFound >= 2) {
-               if (verbose) std::cerr << std::format(" = {}", gear_ratio);
+               if (verbose) TraceEvent<" = {}">(gear_ratio);
                check_sum += gear_ratio;
                }
             // possible check for > 2
 
-            if (verbose) std::cerr << "\n";
+            if (verbose) TraceEvent<"\n">();
 
             pos1++;
             }
 
          }
-      std::cout << check_sum << '\n';
+      result.Answer(check_sum);
+      return result;
       }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "3nd Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution1(input, verbose); break;
-      case 2: Solution2(input, verbose); break;
+      case 1: return Solution1(input, verbose);
+      case 2: return Solution2(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 3nd day.");
       }
    }
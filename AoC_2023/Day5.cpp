@@ -10,6 +10,7 @@
 #include <format>
 #include <ranges>
 #include <limits>
+#include <array>
 
 using namespace std::placeholders;
 
@@ -24,22 +25,20 @@ namespace aoc2023_day5 {
    using bridge_ty  = std::tuple<id_ty, id_ty, offset_ty>;
    using bridges_ty = std::vector<bridge_ty>;
 
-   bridges_ty seed_to_soil_map;
-   bridges_ty soil_to_fertilizer_map;
-   bridges_ty fertilizer_to_water_map;
-   bridges_ty water_to_light_map;
-   bridges_ty light_to_temperature_map;
-   bridges_ty temperature_to_humidity_map;
-   bridges_ty humidity_to_location_map;
+   // thread_local, both parts can run at the same time (AoC_Console --all)
+   thread_local bridges_ty seed_to_soil_map;
+   thread_local bridges_ty soil_to_fertilizer_map;
+   thread_local bridges_ty fertilizer_to_water_map;
+   thread_local bridges_ty water_to_light_map;
+   thread_local bridges_ty light_to_temperature_map;
+   thread_local bridges_ty temperature_to_humidity_map;
+   thread_local bridges_ty humidity_to_location_map;
 
-   inline void read_bridges(bridges_ty& data, std::vector<std::string_view>const& lines) {
+   inline void read_bridges(bridges_ty& data, my_block const& lines) {
       data.clear();
-      for(auto& line : lines) {
-         auto readed = line | std::views::split(' ')
-                            | std::views::filter([](auto p) { return p.size() > 0; })
-                            | std::views::transform([](auto p) { return toInt<id_ty>(std::string_view{ p }); })
-                            | std::ranges::to<std::vector<id_ty>>();
-         if (readed.size() != 3) throw std::runtime_error(std::format("invalid input for bridge: ", line));
+      for(auto const& line : lines) {
+         std::array<id_ty, 3> readed;
+         if (ExtractIntegers<id_ty>(line, readed) != 3) throw std::runtime_error(std::format("invalid input for bridge: {}", line));
          data.emplace_back( std::make_tuple(readed[1], readed[1] + readed[2] - 1, static_cast<offset_ty>(readed[0] - readed[1])));
          }
       //std::ranges::sort(data, [](auto const& lhs, auto const& rhs) { return std::get<0>(lhs) < std::get<0>(rhs); });
@@ -47,11 +46,12 @@ namespace aoc2023_day5 {
 
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 5, .part = part, .strLabel = "the lowest id for location which used for the seed is {}." };
       seeds_ty<part>   seeds {};
 
-      auto processing_block = [&](const std::string_view & first_line, std::vector<std::string_view>const& remaining_lines) {
-         std::map<std::string_view, std::function<void(std::vector<std::string_view>const&)>> steps = {
+      auto processing_block = [&](my_block const& block) {
+         std::map<std::string_view, std::function<void(my_block const&)>> steps = {
                { "seed-to-soil map",            std::bind(read_bridges, std::ref(seed_to_soil_map),            _1) },
                { "soil-to-fertilizer map",      std::bind(read_bridges, std::ref(soil_to_fertilizer_map),      _1) },
                { "fertilizer-to-water map",     std::bind(read_bridges, std::ref(fertilizer_to_water_map),     _1) },
@@ -61,17 +61,17 @@ namespace aoc2023_day5 {
                { "humidity-to-location map",    std::bind(read_bridges, std::ref(humidity_to_location_map),    _1) }
              };
 
-         auto sep_pos = first_line.find(':');
-         auto command_line = first_line.substr(0, sep_pos);
+         static constexpr my_pattern<"{command}:{data}"> block_pattern;
+         const std::string_view first_line = block.front();
+         auto header = block_pattern.match(first_line);
+         if (!header) throw std::runtime_error(std::format("unexpected header \"{}\" of a block in input.", first_line));
+         auto command_line = block_pattern.get<"command">(*header);
 
          if (command_line == "seeds") {
             seeds.clear();
 
-            auto data = first_line.substr(sep_pos + 1, first_line.size() - sep_pos)
-               | std::views::split(' ')
-               | std::views::filter([](auto p) {return p.size() > 0; })
-               | std::views::transform([](auto p) { return toInt<uint64_t>(std::string_view{ p }); })
-               | std::ranges::to<std::vector>();
+            my_small_vector<uint64_t, 32> data;
+            ExtractIntegers(block_pattern.get<"data">(*header), data);
 
             if constexpr (part == EPart_of_Riddle::Part1) std::ranges::copy(data, std::back_inserter(seeds));
             else {
@@ -81,22 +81,16 @@ namespace aoc2023_day5 {
                }
             }
          else {
-            if (auto it = steps.find(command_line); it != steps.end()) it->second(remaining_lines);
+            if (auto it = steps.find(command_line); it != steps.end()) it->second(my_block(std::next(block.begin()), block.end()));
             else throw std::runtime_error(std::format("unexpected block \"{}\" in input.", command_line));
             }
          };
 
 
-
-      std::cout << part << ".\n";
-
-      auto input_vec = input | std::views::transform([](auto p) { return std::string_view{ p }; }) | std::ranges::to<std::vector>();
-      auto blocks = input_vec | std::views::split(std::string_view{});
-      for (auto const& block : blocks) {
-         if (!block.empty()) {
-            processing_block(*block.begin(), { std::next(block.begin()), block.end() });
-            }
-          }
+      {
+      TPhaseTimer phase("parse");
+      for (auto const& block : input.blocks()) processing_block(block);
+      }
 
       auto showSeeds = [](seeds_ty<part> const& seeds) {
          std::cerr << "seed:";
@@ -110,11 +104,12 @@ namespace aoc2023_day5 {
          };
 
       auto showMaps = [](std::string const& strText, bridges_ty const& values) {
-         std::cerr << strText << '\n';
+         auto& err = TOutputCapture::Err();
+         err << strText << '\n';
          for (auto const& [von, bis, offset] : values)
-            std::cerr << "(" << std::setw(22) << von << " - " << std::setw(22) << bis << ") Offet: " 
+            err << "(" << std::setw(22) << von << " - " << std::setw(22) << bis << ") Offet: " 
                       << std::setw(22) << offset << '\n';
-         std::cerr << '\n';
+         err << '\n';
          };
 
       auto findValue = [](bridges_ty const& values, uint64_t value) {
@@ -146,11 +141,22 @@ namespace aoc2023_day5 {
          showMaps("humidity to location", humidity_to_location_map);
          }
 
+      TPhaseTimer phase("simulate");
       uint64_t min_location = std::numeric_limits<uint32_t>::max();
+      size_t iSteps = 0;
+      auto& progress = RiddleProgress();
+      uint64_t iTotal = 0;
+      for (auto const& seed : seeds) iTotal += getSeedRange(seed);
+      progress.Total(iTotal);
       for(auto const& seed : seeds) {
          auto interval = std::views::iota(0) | std::views::take(getSeedRange(seed)) 
                            | std::views::transform([&seed, &getSeedValue](std::size_t i) { return getSeedValue(seed) + i; });
          for (auto seed_val :  interval ) {
+            // the ranges of part 2 have billions of seeds, the riddle can be cancelled
+            if ((++iSteps & 0xF'FFFF) == 0) {
+               progress.Steps(iSteps);
+               CheckCancelled();
+               }
             uint64_t soil        = findValue(seed_to_soil_map, seed_val);
             uint64_t fertilizer  = findValue(soil_to_fertilizer_map, soil);
             uint64_t water       = findValue(fertilizer_to_water_map, fertilizer);
@@ -160,22 +166,23 @@ namespace aoc2023_day5 {
             uint64_t location    = findValue(humidity_to_location_map, humidity);
 
             if(verbose) {
-               std::cerr << "seed:" << seed_val << " (" << getSeedValue(seed) << ")"
-                         << " -> soil: " << soil << " -> fertilizer: " << fertilizer
-                         << " -> water: " << water << " -> light: " << light << " -> temperature: " << temperature
-                         << " -> humidity: " << humidity << " -> location: " << location << '\n';
+               // two events, the nine values are bigger than the arguments of one event
+               TraceEvent<"seed:{} ({}) -> soil: {} -> fertilizer: {} -> water: {}">(static_cast<uint64_t>(seed_val),
+                                                                                     static_cast<uint64_t>(getSeedValue(seed)), soil, fertilizer, water);
+               TraceEvent<" -> light: {} -> temperature: {} -> humidity: {} -> location: {}\n">(light, temperature, humidity, location);
                }
          if (min_location > location) min_location = location;
          }
       }
-      std::cout << "the lowest id for location which used for the seed is " << min_location << ".\n";
+      PhaseCounter("seeds", iSteps);
+      result.Answer(min_location);
+      return result;
       }
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "5th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
          switch (part) {
-         case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-         case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+         case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+         case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
          default: throw std::runtime_error("unexpexted part for the riddle at 6th day.");
          }
    }
@@ -15,7 +15,8 @@ using namespace std::placeholders;
 namespace aoc2023_day6 {
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 6, .part = part, .strLabel = "The product of the number of ways to surpass the record is {}." };
 
       using number_ty = std::conditional_t<part == EPart_of_Riddle::Part1, size_t, unsigned long long>;
 
@@ -27,16 +28,14 @@ namespace aoc2023_day6 {
          static auto readData = [](std::string_view line, std::vector<number_ty>& data) {
                 data.clear();
                 if constexpr (part == EPart_of_Riddle::Part1)
-                   std::ranges::copy(line | std::views::split(' ') | std::views::filter([](auto p) {return p.size() > 0; })
-                                          | std::views::transform([](auto p) { return toInt<number_ty>(std::string_view{ p }); })
-                                     , std::back_inserter(data));
+                   ExtractIntegers(line, data);
                 else {
                    auto withoutSpaces = line | std::views::filter([](char c) { return !std::isspace(c); });
                    data.emplace_back(toInt<number_ty>(std::string { withoutSpaces.begin(), withoutSpaces.end() } ));
                    }
                 };
 
-         static std::map<std::string, std::function<void (std::string_view)>> contrl { 
+         std::map<std::string, std::function<void (std::string_view)>> contrl { 
                    { "Time"s,     std::bind(readData, _1, std::ref(times)) },
                    { "Distance"s, std::bind(readData, _1, std::ref(distances))  }
                   };
@@ -55,14 +54,12 @@ namespace aoc2023_day6 {
                                 [](const auto& race) { return std::make_pair(std::get<0>(race), std::get<1>(race)); });
          };
 
-      std::cout << part << ".\n";
-
       try {
          reading();
 
          if(verbose) {
             for (size_t i = 0; auto const& [time, distance] : races)
-               std::cerr << std::format("Race {:2d}:{:5d} ms / {:5d} mm\n", ++i, time, distance);
+               TraceEvent<"Race {:2d}:{:5d} ms / {:5d} mm\n">(++i, time, distance);
             }
 
          number_ty solution = 1;
@@ -78,24 +75,22 @@ namespace aoc2023_day6 {
 
             number_ty ways_to_beat = border.second - border.first + 1;
 
-            if(verbose) {
-               std::cerr << std::format("{} - {}, Count =  {}\n", border.first, border.second, ways_to_beat);
-               }
+            if(verbose) TraceEvent<"{} - {}, Count =  {}\n">(border.first, border.second, ways_to_beat);
             solution *= ways_to_beat;
             }
 
-         std::cout << "The product of the number of ways to surpass the record is " << solution << ".\n";
+         result.Answer(solution);
          }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 6, " << part << ": "<< ex.what() << '\n';
          }
+      return result;
       }
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "6th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 6th day.");
       }
    }
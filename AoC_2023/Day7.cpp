@@ -6,7 +6,6 @@
 #include <tuple>
 #include <vector>
 #include <map>
-#include <regex>
 #include <stdexcept>
 #include <algorithm>
 #include <functional>
@@ -22,26 +21,26 @@ namespace aoc2023_day7 {
    enum class ERank_of_Hands : uint8_t { noScore = 0, HighCard, OnePair, TwoPairs, Three_of_Kind, Full_House, 
                                          Four_of_Kind, Five_of_Kind };
 
-   std::ostream& operator << (std::ostream& out, ERank_of_Hands rank) {
+   /// name of the rank, a literal, so trace events can refer to it
+   std::string_view RankText(ERank_of_Hands rank) {
       switch(rank) {
-         case ERank_of_Hands::noScore:       out << "no Score"; break;
-         case ERank_of_Hands::HighCard:      out << "HighCard"; break;
-         case ERank_of_Hands::OnePair:       out << "OnePair"; break;
-         case ERank_of_Hands::TwoPairs:      out << "TwoPairs"; break;
-         case ERank_of_Hands::Three_of_Kind: out << "Three_of_Kind"; break;
-         case ERank_of_Hands::Full_House:    out << "Full_House"; break;
-         case ERank_of_Hands::Four_of_Kind:  out << "Four_of_Kind"; break;
-         case ERank_of_Hands::Five_of_Kind:  out << "Five_of_Kind"; break;
+         case ERank_of_Hands::noScore:       return "no Score";
+         case ERank_of_Hands::HighCard:      return "HighCard";
+         case ERank_of_Hands::OnePair:       return "OnePair";
+         case ERank_of_Hands::TwoPairs:      return "TwoPairs";
+         case ERank_of_Hands::Three_of_Kind: return "Three_of_Kind";
+         case ERank_of_Hands::Full_House:    return "Full_House";
+         case ERank_of_Hands::Four_of_Kind:  return "Four_of_Kind";
+         case ERank_of_Hands::Five_of_Kind:  return "Five_of_Kind";
          default: throw std::runtime_error("unexpected");
          }
-      return out;
       }
 
    using card_ty = std::tuple<std::string, size_t, ERank_of_Hands>;
 
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
+   riddle_result Solution(my_lines input, bool verbose) {
       // clang-format off
       static const std::map<char, size_t> Rank_of_Cards = []() -> std::map<char, size_t> {
                                                  if constexpr (part == EPart_of_Riddle::Part1)
@@ -64,7 +63,8 @@ namespace aoc2023_day7 {
          };
 
 
-      auto CalculateScore = [](card_ty& deck, bool verbose) -> card_ty {
+      // cards is the view of the hand in the input for the trace events, the string of the deck is moved
+      auto CalculateScore = [](card_ty& deck, std::string_view cards, bool verbose) -> card_ty {
          auto constexpr CompScore = [](auto lhs, auto rhs) { return lhs.second < rhs.second; };
          
          std::map<char, size_t> result;
@@ -93,9 +93,7 @@ namespace aoc2023_day7 {
                }
 
 
-            if(verbose) {
-               std::cerr << std::get<0>(deck) << " = " << std::get<2>(deck) << '\n';
-               }
+            if(verbose) TraceEvent<"{} = {}\n">(cards, RankText(std::get<2>(deck)));
             }
          else {
             using CalcRank = std::map<std::pair<size_t, std::vector<size_t>>, ERank_of_Hands>;
@@ -141,11 +139,8 @@ namespace aoc2023_day7 {
                throw std::runtime_error("unexpected score in recalculation.");
                }
             
-            if(verbose) {
-               std::cerr << sum << " " << std::get<0>(deck) << " = " << std::get<2>(deck) << " / " << GetCards(deck);
-               for (auto val : counts) std::cerr << " " << val;
-               std::cerr << '\n';
-               }
+            if(verbose) TraceEvent<"{} = {} / jokers {}, highest count {}\n">(cards, RankText(std::get<2>(deck)), seek.first,
+                                                                                 counts.empty() ? size_t { 0 } : counts.front());
             }
 
 
@@ -172,29 +167,30 @@ namespace aoc2023_day7 {
          };
       // clang-format on
 
-      std::cout << part << ".\n";
-
+      riddle_result result { .day = 7, .part = part };
       try {
 
-         std::vector<card_ty> decks;
-         for (auto const& line : input | std::views::transform([](auto p) { return std::string_view{ p }; })) {
-            static const std::regex parser_input("^([AKQJT2-9]{5})\\s+([1-9][0-9]{0,4})$");
-            std::string strLine = to_String(line);
-            if (std::regex_match(strLine, parser_input));
-            else throw std::runtime_error("The input line \""s + strLine + "\" don't match the rules."s);
-
-            std::smatch match;
-            if (std::regex_search(strLine, match, parser_input)) {
-               card_ty card;
-               std::get<0>(card) = match[1];
-               std::get<1>(card) = toInt<size_t>(match[2]);
-               std::get<2>(card) = ERank_of_Hands::noScore;
-               decks.emplace_back(std::move(card));
-               }
-            else throw std::runtime_error("unexpected input, can't parse the line.");
-            }
+         using decks_ty = std::vector<card_ty>;
+
+         // read and score the hands in parallel chunks, the decks are joined in the order of the input
+         auto read_hand = [&CalculateScore, verbose](decks_ty& decks, std::string_view line) {
+            static constexpr my_pattern<"{cards:5} {bid:uint}"> parser_input;
+            auto hand = parser_input.match(line);
+            if (!hand || parser_input.get<"cards">(*hand).find_first_not_of("AKQJT23456789") != std::string_view::npos)
+               throw std::runtime_error(std::format("The input line \"{}\" don't match the rules.", line));
+
+            card_ty card;
+            std::string_view cards = parser_input.get<"cards">(*hand);
+            std::get<0>(card) = to_String(cards);
+            std::get<1>(card) = static_cast<size_t>(parser_input.get<"bid">(*hand));
+            std::get<2>(card) = ERank_of_Hands::noScore;
+            decks.emplace_back(CalculateScore(card, cards, verbose));
+            };
+
+         auto decks = input.map_reduce(decks_ty { }, read_hand,
+                                       [](decks_ty& total, decks_ty&& chunk) { std::ranges::move(chunk, std::back_inserter(total)); },
+                                       verbose ? 1 : 0);
 
-         std::transform(decks.begin(), decks.end(), decks.begin(), std::bind(CalculateScore, _1, verbose));
          std::sort(decks.begin(), decks.end(), CompareScore);
 
          auto calc_values = std::views::zip(std::views::iota(1), decks)
@@ -203,19 +199,19 @@ namespace aoc2023_day7 {
          auto sum = std::accumulate(calc_values.begin(), calc_values.end(), 0ull, [](uint64_t partialSum, auto const& p) {
                              return static_cast<uint64_t>(partialSum + (p.first * std::get<1>(p.second))); });
          
-         std::cout << "solution = " << sum << '\n';
+         result.Answer(sum);
          }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 7, " << part << ": " << ex.what() << '\n';
          }
+      return result;
       }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "7th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 7th day.");
       }
    }
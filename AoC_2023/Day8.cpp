@@ -5,11 +5,11 @@
 #include <vector>
 #include <set>
 #include <stdexcept>
-#include <regex>
 #include <iterator>
 #include <ranges>
 #include <coroutine>
 #include <variant>
+#include <optional>
 
 
 namespace aoc2023_day8 {
@@ -83,7 +83,10 @@ namespace aoc2023_day8 {
    
 
 
-  using network_points_ty = std::map<std::string, int>;
+  using network_points_ty = std::map<std::string_view, size_t>;
+
+  /// line of the network, node followed by the left and right target
+  using node_pattern = my_pattern<"{node:3} = ({left:3}, {right:3})">;
 
   using data_ty = std::tuple<std::string, size_t, size_t, bool, bool>;
   using network_ty = std::map<size_t, data_ty>;
@@ -91,81 +94,60 @@ namespace aoc2023_day8 {
   using network_vec = std::vector <data_ty>;
 
    template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
-      std::cout << part << ".\n";
-
+   riddle_result Solution(my_lines input, bool verbose) {
+      riddle_result result { .day = 8, .part = part };
       try {
-         std::string command;
-         for(auto const& line : input | std::ranges::views::take(1) | std::views::transform([](auto p) { return std::string_view{ p }; })) {
-            command = to_String(line);
-            }
+         if (input.size() == 0) throw std::runtime_error("input is empty, expected the commands in the first line");
+         std::string command = to_String(input[0]);
 
          auto repeat_commands = repeat_sequence(command);
 
-         std::cout << '\n';
-
          network_points_ty network_points;
          //network_ty network;
          network_vec network;
 
-         // regulärer Ausdruck zum Lesen der Schlüssel
-         static std::regex key_pattern(R"(^([A-Z]{3})\s*)");
-         auto key_vector_input = input | std::ranges::views::drop(2) 
-                                       | std::views::transform([](auto p) {
-                                               auto text = std::string_view{ p };
-                                               auto pos  = text.find('=');
-                                               return std::string_view{ p }.substr(0, pos); })
-                                       | std::ranges::to<std::vector<std::string_view>>();
-
-         std::ranges::for_each(std::views::zip(input | std::ranges::views::drop(2) , std::views::iota(0)),
-            [&](const auto& tuple) {
-               auto [current_str, current_id] = tuple;
-               std::string_view key_vw = current_str.substr(0, current_str.find('='));
-               key_vw = key_vw.substr(0, key_vw.find_last_not_of(" ") + 1);
-               std::string key_str;
-               std::ranges::transform(key_vw, std::back_inserter(key_str), [](char c) { return !std::isspace(c) ? c : '\0'; });
-               network_points.insert( { key_str, static_cast<uint16_t>(current_id) } );
-            });
+         std::optional<TPhaseTimer> phase(std::in_place, "parse");
+         // first pass, read the keys, the views point into the input and stay valid
+         for (size_t current_id = 0; auto const& line : input | std::ranges::views::drop(2)) {
+            if (auto matches = node_pattern::match(line); matches) 
+               network_points.insert( { node_pattern::get<"node">(*matches), current_id++ } );
+            }
 
          network.reserve(network_points.size());
 
-         //static std::regex pattern(R"(^([A-Z]{3})\s*=\s*\(([A-Z]{3}),\s*([A-Z]{3})\)$)");
-         static std::regex pattern(R"(^([A-Z1-9]{3})\s*=\s*\(([A-Z1-9]{3}),\s*([A-Z1-9]{3})\)$)");
-         for (auto const& line : input | std::ranges::views::drop(2) | std::views::transform([](auto p) { return std::string_view{ p }; })) {
-            std::string strLine = to_String(line);
-            std::smatch matches;
-            if (std::regex_match(strLine, matches, pattern)) {
-               std::string node         = matches[1];
-               std::string left_target  = matches[2];
-               std::string right_target = matches[3];
+         for (auto const& line : input | std::ranges::views::drop(2)) {
+            if (auto matches = node_pattern::match(line); matches) {
+               std::string_view node         = node_pattern::get<"node">(*matches);
+               std::string_view left_target  = node_pattern::get<"left">(*matches);
+               std::string_view right_target = node_pattern::get<"right">(*matches);
 
                if(verbose) {
-                  std::cerr << "node: " << node << ", left: " << left_target << ", right: " << right_target << std::endl;
-                  if (node == "AAA" || node == "ZZZ") std::cerr << " --------> " << strLine << '\n';
+                  TraceEvent<"node: {}, left: {}, right: {}\n">(node, left_target, right_target);
+                  if (node == "AAA" || node == "ZZZ") TraceEvent<" --------> {}\n">(line);
                   }
 
 
-               static auto Starting = [](std::string const& node) {
+               static auto Starting = [](std::string_view node) {
                   if constexpr (part == EPart_of_Riddle::Part1)
                      return node == "AAA";
                   else
                      return node.back() == 'A';
                   };
 
-               static auto Finishing = [](std::string const& node) {
+               static auto Finishing = [](std::string_view node) {
                   if constexpr (part == EPart_of_Riddle::Part1)
                      return node == "ZZZ";
                   else
                      return node.back() == 'Z';
                   };
 
-               auto find_id = [&network_points](std::string const& node) -> size_t {
+               auto find_id = [&network_points](std::string_view node) -> size_t {
                   if (auto it = network_points.find(node); it != network_points.end()) return it->second;
                   else throw std::runtime_error("critical error, node not found");
                   };
 
                //network.insert({ find_id(node), { node, find_id(left_target), find_id(right_target), Starting(node), Finishing(node) } });
-               network.emplace_back(data_ty { node, find_id(left_target), find_id(right_target), Starting(node), Finishing(node) });
+               network.emplace_back(data_ty { std::string { node }, find_id(left_target), find_id(right_target), Starting(node), Finishing(node) });
             }
             else {
                std::cout << "error\n";
@@ -173,16 +155,18 @@ namespace aoc2023_day8 {
             }
 
          if(verbose) {
-            std::cerr << "Starting points:\n";
+            TraceEvent<"Starting points:\n">();
             for (const auto& element : network) {
                //if (std::get<3>(element.second) == true) std::cerr << std::get<0>(element.second) << '\n';
-               if (std::get<3>(element) == true) std::cerr << std::get<0>(element) << '\n';
+               if (std::get<3>(element) == true) TraceEvent<"{}\n">(std::string_view { std::get<0>(element) });
             }
-            std::cerr << "Finishing points:\n";
+            TraceEvent<"Finishing points:\n">();
             for (const auto& element : network) {
                //if (std::get<4>(element.second) == true) std::cerr << std::get<0>(element.second) << '\n';
-               if (std::get<4>(element) == true) std::cerr << std::get<0>(element) << '\n';
+               if (std::get<4>(element) == true) TraceEvent<"{}\n">(std::string_view { std::get<0>(element) });
             }
+            // the names refer to the strings in the network
+            TraceFlush();
             }
 
          size_t iCount = 0;
@@ -212,34 +196,35 @@ namespace aoc2023_day8 {
             return true;
             };
 
-         QCoreApplication::processEvents();
+         phase.emplace("walk");
+         auto& progress = RiddleProgress();
          for (auto ch : repeat_commands) {
             //for(auto& it : start_points) it = network.find(ch == 'L' ? std::get<1>(it->second) : std::get<2>(it->second));
             for (auto& it : start_points) it = (ch == 'L' ? std::get<1>(network[it]) : std::get<2>(network[it]));
             ++iCount;
-            if(iCount % 100000000 == 0) {
-               std::cout << std::setw(20) << iCount << ":";
-               for (auto const& it : start_points) std::cout << " " << std::get<0>(network[it]);
-               std::cout << '\n';
-               QCoreApplication::processEvents();
+            // part 2 runs billions of steps, the progress is polled by the user interface and
+            // the riddle can be cancelled by the user or the time budget
+            if ((iCount & 0xF'FFFF) == 0) {
+               progress.Steps(iCount);
+               CheckCancelled();
                }
             if (test_finishing(start_points)) break;
             }
 
-         std::cout << "Count of nodes = " << network.size() << '\n';
-         std::cout << "solution = " << iCount << '\n';
+         result.Counter("nodes", network.size());
+         result.Answer(iCount);
          }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 8, " << part << ": " << ex.what() << '\n';
       }
+      return result;
    }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "8th Day, ";
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 8th day.");
       }
    }
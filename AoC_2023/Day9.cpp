@@ -8,48 +8,45 @@
 #include <ranges>
 #include <algorithm>
 #include <numeric>
+#include <limits>
 
 namespace aoc2023_day9 {
 
-   using data_ty = int32_t;
+   // the differences and the sum of millions of lines (streamed inputs) leave the range of int32_t
+   using data_ty = int64_t;
    using data_line_ty = std::vector<data_ty>;
    using data_lines_ty = std::vector<data_line_ty>;
 
    inline void read_data_line(data_line_ty& data, std::string_view line) {
       data.clear();
-      std::ranges::copy(line | std::views::split(' ')
-                             | std::views::filter([](auto p) { return p.size() > 0; })
-                             | std::views::transform([](auto p) { return toInt<data_ty>(std::string_view{ p }); })
-                        , std::back_inserter(data));
+      ExtractIntegers(line, data);
       }
 
-   template <EPart_of_Riddle part>
-   void Solution(my_lines input, bool verbose) {
-      std::cout << part << ".\n";
-
+   /// the lines are independent, the input is a my_lines or for big files a my_stream_lines
+   template <EPart_of_Riddle part, typename input_ty>
+   riddle_result Solution(input_ty& input, bool verbose) {
+      riddle_result result { .day = 9, .part = part };
       try {
  
          auto print = [](data_line_ty const& line) {
             for (size_t i = 0; auto col : line)
-               std::cerr << (i++ > 0 ? ", " : "") << col;
-            std::cerr << '\n';
+               TraceEvent<"{}{}">(std::string_view { i++ > 0 ? ", " : "" }, col);
+            TraceEvent<"\n">();
             };
 
-         data_lines_ty all_lines;
-         for (auto line : input | std::views::filter([](auto p) { return p.size() > 0; })) {
-            data_line_ty  one_line;
-            read_data_line(one_line, line);
-            all_lines.emplace_back(std::move(one_line));
-            }
-
-         for (size_t line = 0; line < all_lines.size();++line) {
-            if (verbose) print(all_lines[line]);
-            
-            if(all_lines[line].size() > 1) {
+         // every line is extrapolated on its own, the lines are processed in parallel chunks
+         auto extrapolate = [verbose, &print](data_ty& sum, std::string_view line) {
+            if (line.empty()) return;
+
+            data_line_ty values;
+            read_data_line(values, line);
+            if (verbose) print(values);
+
+            if(values.size() > 1) {
                data_lines_ty differences;
                data_line_ty data;
-               for (size_t idx = 1; idx < all_lines[line].size(); ++idx) {
-                  data.emplace_back(all_lines[line][idx] - all_lines[line][idx - 1]);
+               for (size_t idx = 1; idx < values.size(); ++idx) {
+                  data.emplace_back(values[idx] - values[idx - 1]);
                   }
                differences.emplace_back(std::move(data));
                if (verbose) print(differences[0]);
@@ -72,55 +69,112 @@ namespace aoc2023_day9 {
                      differences[idx3 - 1].emplace(differences[idx3 - 1].begin(), differences[idx3 - 1].front() - differences[idx3].front());
 
                if constexpr (part == EPart_of_Riddle::Part1)
-                  all_lines[line].emplace_back(all_lines[line].back() + differences[0].back());
+                  values.emplace_back(values.back() + differences[0].back());
                else
-                  all_lines[line].emplace(all_lines[line].begin(), all_lines[line].front() - differences[0].front());
+                  values.emplace(values.begin(), values.front() - differences[0].front());
 
                if (verbose) {
-                  std::cerr << "------------ Result --------------------------\n";
-                  print(all_lines[line]);
-                  std::cerr << "------------ Finish --------------------------\n\n";
+                  TraceEvent<"------------ Result --------------------------\n">();
+                  print(values);
+                  TraceEvent<"------------ Finish --------------------------\n\n">();
                   }
                }
             else {
                throw std::runtime_error("input can't processed");
                }
-            }
-
-         if(verbose) {
-            std::cerr << "Values with added next position:\n";
-            for (auto const& line : all_lines) {
-               for (size_t i = 0; auto col : line)
-                  std::cerr << (i++ > 0 ? ", " : "") << col;
-               std::cerr << '\n';
-               }
-            }
-
-         data_ty  result = std::accumulate(all_lines.begin(), all_lines.end(), 0, [](data_ty sum, std::vector<data_ty>const& data) {
-                        if (!data.empty()) {
-                            if constexpr (part == EPart_of_Riddle::Part1) 
-                               return sum += data.back();
-                            else
-                               return sum += data.front();
-                            }
-                         else return sum;
-                         });
-
-         std::cout << "solution = " << result << '\n';
+
+            if constexpr (part == EPart_of_Riddle::Part1)
+               sum += values.back();
+            else
+               sum += values.front();
+            };
+
+         result.Answer(input.map_reduce(data_ty { 0 }, extrapolate, my_add_to{}, verbose ? 1 : 0));
          }
       catch (std::exception& ex) {
          std::cerr << "error in program for day 9, " << part << ": " << ex.what() << '\n';
       }
+      return result;
    }
 
 
-   void Riddle(int part, my_lines input, bool verbose) {
-      std::cout << "9th Day, ";
+   /// lhs * rhs, throws std::overflow_error when the product leaves the range of int64_t
+   inline int64_t CheckedMul(int64_t lhs, int64_t rhs) {
+      constexpr auto min = std::numeric_limits<int64_t>::min();
+      if ((lhs == -1 && rhs == min) || (rhs == -1 && lhs == min)) throw std::overflow_error("day 9, product leaves the range of int64_t");
+      const auto product = static_cast<int64_t>(static_cast<uint64_t>(lhs) * static_cast<uint64_t>(rhs));
+      if (lhs != 0 && product / lhs != rhs) throw std::overflow_error("day 9, product leaves the range of int64_t");
+      return product;
+      }
+
+   /// lhs + rhs, throws std::overflow_error when the sum leaves the range of int64_t
+   inline int64_t CheckedAdd(int64_t lhs, int64_t rhs) {
+      if ((rhs > 0 && lhs > std::numeric_limits<int64_t>::max() - rhs) || (rhs < 0 && lhs < std::numeric_limits<int64_t>::min() - rhs))
+         throw std::overflow_error("day 9, sum leaves the range of int64_t");
+      return lhs + rhs;
+      }
+
+   /// variant without the difference tables. a line of n values is a polynomial of a degree below n, the
+   /// next value is sum (-1)^(n-1-i) * C(n, i) * v[i], the value in front sum (-1)^i * C(n, i+1) * v[i].
+   /// the binomials are built with the line, the values stay inline for lines up to 32 values
+   template <EPart_of_Riddle part>
+   riddle_result FastSolution(my_lines& input, bool) {
+      riddle_result result { .day = 9, .part = part };
+      try {
+         auto extrapolate = [](int64_t& sum, std::string_view line) {
+            if (line.empty()) return;
+
+            my_small_vector<int64_t, 32> values;
+            ExtractIntegers(line, values);
+            const size_t count = values.size();
+            if (count < 2) throw std::runtime_error("input can't processed");
+
+            // the binomials grow fast with the count of values, the products and sums are checked, a line
+            // which leaves the range of int64_t throws instead of a wrong answer
+            int64_t value = 0, binomial = 1;   // C(count, 0)
+            for (size_t idx = 0; idx < count; ++idx) {
+               if constexpr (part == EPart_of_Riddle::Part1) {
+                  value = CheckedAdd(value, CheckedMul((count - 1 - idx) % 2 == 0 ? binomial : -binomial, values[idx]));
+                  binomial = CheckedMul(binomial, static_cast<int64_t>(count - idx)) / static_cast<int64_t>(idx + 1);
+                  }
+               else {
+                  binomial = CheckedMul(binomial, static_cast<int64_t>(count - idx)) / static_cast<int64_t>(idx + 1);
+                  value = CheckedAdd(value, CheckedMul(idx % 2 == 0 ? binomial : -binomial, values[idx]));
+                  }
+               }
+            sum = CheckedAdd(sum, value);
+            };
+
+         result.Answer(input.map_reduce(int64_t { 0 }, extrapolate, my_add_to{}));
+         }
+      catch (std::exception& ex) {
+         std::cerr << "error in program for day 9, " << part << ": " << ex.what() << '\n';
+      }
+      return result;
+   }
+
+   riddle_result Riddle(int part, my_lines input, bool verbose) {
       switch (part) {
-      case 1: Solution<EPart_of_Riddle::Part1>(input, verbose); break;
-      case 2: Solution<EPart_of_Riddle::Part2>(input, verbose); break;
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
       default: throw std::runtime_error("unexpexted part for the riddle at 8th day.");
       }
    }
 
+   riddle_result FastRiddle(int part, my_lines input, bool verbose) {
+      switch (part) {
+      case 1: return FastSolution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return FastSolution<EPart_of_Riddle::Part2>(input, verbose);
+      default: throw std::runtime_error("unexpexted part for the riddle at 9th day.");
+      }
+   }
+
+   riddle_result StreamRiddle(int part, my_stream_lines& input, bool verbose) {
+      switch (part) {
+      case 1: return Solution<EPart_of_Riddle::Part1>(input, verbose);
+      case 2: return Solution<EPart_of_Riddle::Part2>(input, verbose);
+      default: throw std::runtime_error("unexpexted part for the riddle at 9th day.");
+      }
+   }
+
 } // end of namespace
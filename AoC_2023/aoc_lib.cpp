@@ -0,0 +1,848 @@
+#include "aoc_lib.h"
+
+#include <string>
+#include <stdexcept>
+#include <filesystem>
+#include <algorithm>
+#include <new>
+#include <thread>
+#include <cstdlib>
+
+#if defined(_WIN32)
+   #define WIN32_LEAN_AND_MEAN
+   #define NOMINMAX
+   #include <windows.h>
+   #include <psapi.h>
+   #include <malloc.h>
+#else
+   #include <fcntl.h>
+   #include <unistd.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <sys/resource.h>
+   #if defined(__APPLE__)
+      #include <malloc/malloc.h>
+   #else
+      #include <malloc.h>
+   #endif
+   #if defined(__linux__)
+      #include <linux/perf_event.h>
+      #include <sys/syscall.h>
+      #include <sys/ioctl.h>
+      #include <cerrno>
+   #endif
+#endif
+
+using namespace std::literals::string_literals;
+
+// --------------------------------------------------------------------
+// results of the riddles
+// --------------------------------------------------------------------
+
+std::string to_String(my_uint128 const& value) {
+   if (value.high == 0u) return std::to_string(value.low);
+   // long division by 10^9 with 32 bit digits, so the rest of every step fits in 64 bit
+   constexpr uint64_t divisor = 1'000'000'000u;
+   std::array<uint32_t, 4> digits = { static_cast<uint32_t>(value.high >> 32), static_cast<uint32_t>(value.high),
+                                      static_cast<uint32_t>(value.low >> 32),  static_cast<uint32_t>(value.low) };
+   std::vector<uint64_t> parts;
+   while (std::ranges::any_of(digits, [](uint32_t digit) { return digit != 0u; })) {
+      uint64_t rest = 0u;
+      for (auto& digit : digits) {
+         rest = (rest << 32) | digit;
+         digit = static_cast<uint32_t>(rest / divisor);
+         rest %= divisor;
+         }
+      parts.emplace_back(static_cast<uint64_t>(rest));
+      }
+   std::string result = std::to_string(parts.back());
+   for (auto it = parts.rbegin() + 1; it != parts.rend(); ++it) result += std::format("{:09}", *it);
+   return result;
+   }
+
+std::string AnswerText(riddle_result const& result) {
+   return std::visit([]<typename ty>(ty const& value) -> std::string {
+      if constexpr (std::is_same_v<ty, std::monostate>) return { };
+      else if constexpr (std::is_same_v<ty, std::string>) return value;
+      else return to_String(value);
+      }, result.answer);
+   }
+
+std::string Render(riddle_result const& result) {
+   std::ostringstream os;
+   os << std::format("Day {}, ", result.day) << static_cast<EPart_of_Riddle>(result.part) << ".\n";
+   if (auto strAnswer = AnswerText(result); result.HasAnswer())
+      os << std::vformat(result.strLabel, std::make_format_args(strAnswer)) << '\n';
+   else os << "no answer\n";
+   for (auto const& counter : result.counters) os << std::format("   {} = {}\n", counter.name, counter.value);
+   return os.str();
+   }
+
+std::string EscapeJson(std::string_view text) {
+   std::string result;
+   result.reserve(text.size());
+   for (char c : text) {
+      switch (c) {
+         case '"':  result += "\\\""; break;
+         case '\\': result += "\\\\"; break;
+         case '\n': result += "\\n"; break;
+         case '\t': result += "\\t"; break;
+         default:
+            if (static_cast<unsigned char>(c) < 0x20) result += std::format("\\u{:04x}", static_cast<int>(c));
+            else result += c;
+         }
+      }
+   return result;
+   }
+
+void WriteChromeTrace(std::ostream& out, riddle_result const& result) {
+   auto us = [](std::chrono::nanoseconds time) { return time.count() / 1'000.0; };
+   out << "{\"traceEvents\": [\n"
+       << std::format("  {{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {{\"name\": \"Day {}, part {}\"}}}}",
+                      result.day, result.part);
+   uint32_t iThreads = 0;
+   std::chrono::nanoseconds end { 0 };
+   for (auto const& phase : result.phases) {
+      out << std::format(",\n  {{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}}",
+                         EscapeJson(phase.name), phase.thread, us(phase.start), us(phase.time));
+      iThreads = std::max(iThreads, phase.thread + 1);
+      end      = std::max(end, phase.start + phase.time);
+      }
+   for (uint32_t i = 0; i < iThreads; ++i)
+      out << std::format(",\n  {{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": {}, \"args\": {{\"name\": \"{}\"}}}}",
+                         i, i == 0 ? "riddle"s : std::format("worker {}", i));
+   if (!result.counters.empty()) {
+      out << std::format(",\n  {{\"name\": \"counters\", \"ph\": \"C\", \"pid\": 1, \"tid\": 0, \"ts\": {:.3f}, \"args\": {{", us(end));
+      for (size_t i = 0; auto const& counter : result.counters)
+         out << std::format("{}\"{}\": {}", i++ > 0 ? ", " : "", EscapeJson(counter.name), counter.value);
+      out << "}}";
+      }
+   out << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+   }
+
+// --------------------------------------------------------------------
+// hashing (XXH64)
+// --------------------------------------------------------------------
+
+namespace {
+   constexpr uint64_t prime64_1 = 0x9E3779B185EBCA87ull;
+   constexpr uint64_t prime64_2 = 0xC2B2AE3D27D4EB4Full;
+   constexpr uint64_t prime64_3 = 0x165667B19E3779F9ull;
+   constexpr uint64_t prime64_4 = 0x85EBCA77C2B2AE63ull;
+   constexpr uint64_t prime64_5 = 0x27D4EB2F165667C5ull;
+
+   template <typename ty>
+   ty Read(const char* data) {
+      ty value;
+      std::memcpy(&value, data, sizeof(ty));
+      if constexpr (std::endian::native == std::endian::big) value = std::byteswap(value);
+      return value;
+      }
+
+   uint64_t Round(uint64_t acc, uint64_t input) {
+      return std::rotl(acc + input * prime64_2, 31) * prime64_1;
+      }
+
+   uint64_t Merge(uint64_t acc, uint64_t value) {
+      return (acc ^ Round(0, value)) * prime64_1 + prime64_4;
+      }
+   }
+
+uint64_t HashBytes(std::string_view data, uint64_t seed) {
+   const char* ptr = data.data();
+   const char* end = ptr + data.size();
+   uint64_t hash;
+   if (data.size() >= 32) {
+      uint64_t v1 = seed + prime64_1 + prime64_2, v2 = seed + prime64_2, v3 = seed, v4 = seed - prime64_1;
+      for (; ptr + 32 <= end; ptr += 32) {
+         v1 = Round(v1, Read<uint64_t>(ptr));
+         v2 = Round(v2, Read<uint64_t>(ptr + 8));
+         v3 = Round(v3, Read<uint64_t>(ptr + 16));
+         v4 = Round(v4, Read<uint64_t>(ptr + 24));
+         }
+      hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+      hash = Merge(Merge(Merge(Merge(hash, v1), v2), v3), v4);
+      }
+   else hash = seed + prime64_5;
+
+   hash += data.size();
+   for (; ptr + 8 <= end; ptr += 8) hash = std::rotl(hash ^ Round(0, Read<uint64_t>(ptr)), 27) * prime64_1 + prime64_4;
+   if (ptr + 4 <= end) {
+      hash = std::rotl(hash ^ (Read<uint32_t>(ptr) * prime64_1), 23) * prime64_2 + prime64_3;
+      ptr += 4;
+      }
+   for (; ptr < end; ++ptr) hash = std::rotl(hash ^ (static_cast<unsigned char>(*ptr) * prime64_5), 11) * prime64_1;
+
+   hash ^= hash >> 33;
+   hash *= prime64_2;
+   hash ^= hash >> 29;
+   hash *= prime64_3;
+   hash ^= hash >> 32;
+   return hash;
+   }
+
+// --------------------------------------------------------------------
+// TMappedFile
+// --------------------------------------------------------------------
+
+#if defined(_WIN32)
+
+TMappedFile::TMappedFile(std::filesystem::path const& strFile, my_mapping_options const& options) {
+   DWORD flags = FILE_ATTRIBUTE_NORMAL | (options.sequential ? FILE_FLAG_SEQUENTIAL_SCAN : 0);
+   HANDLE hFile = ::CreateFileW(strFile.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+   if (hFile == INVALID_HANDLE_VALUE) [[unlikely]] throw std::runtime_error("file \""s + strFile.string() + "\" can't opened"s);
+
+   LARGE_INTEGER size;
+   if (!::GetFileSizeEx(hFile, &size)) [[unlikely]] {
+      ::CloseHandle(hFile);
+      throw std::runtime_error("size of file \""s + strFile.string() + "\" can't determined"s);
+      }
+   theSize = static_cast<size_t>(size.QuadPart);
+
+   // an empty file can't mapped, the view stays empty
+   if (theSize > 0) {
+      theHandle = ::CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      ::CloseHandle(hFile);
+      if (theHandle == nullptr) [[unlikely]] throw std::runtime_error("file \""s + strFile.string() + "\" can't mapped"s);
+
+      theData = static_cast<const char*>(::MapViewOfFile(theHandle, FILE_MAP_READ, 0, 0, 0));
+      if (theData == nullptr) [[unlikely]] {
+         ::CloseHandle(theHandle);
+         theHandle = nullptr;
+         throw std::runtime_error("view for file \""s + strFile.string() + "\" can't created"s);
+         }
+
+      if (options.populate) {
+         WIN32_MEMORY_RANGE_ENTRY range { const_cast<char*>(theData), theSize };
+         ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+         }
+      }
+   else ::CloseHandle(hFile);
+   }
+
+TMappedFile::~TMappedFile() {
+   if (theData != nullptr) ::UnmapViewOfFile(theData);
+   if (theHandle != nullptr) ::CloseHandle(theHandle);
+   }
+
+#else
+
+TMappedFile::TMappedFile(std::filesystem::path const& strFile, my_mapping_options const& options) {
+   int fd = ::open(strFile.c_str(), O_RDONLY);
+   if (fd < 0) [[unlikely]] throw std::runtime_error("file \""s + strFile.string() + "\" can't opened"s);
+
+   struct stat info;
+   if (::fstat(fd, &info) != 0) [[unlikely]] {
+      ::close(fd);
+      throw std::runtime_error("size of file \""s + strFile.string() + "\" can't determined"s);
+      }
+   theSize = static_cast<size_t>(info.st_size);
+
+   // an empty file can't mapped, the view stays empty
+   if (theSize > 0) {
+      int flags = MAP_PRIVATE;
+      #if defined(MAP_POPULATE)
+         if (options.populate) flags |= MAP_POPULATE;
+      #endif
+      void* addr = ::mmap(nullptr, theSize, PROT_READ, flags, fd, 0);
+      ::close(fd);
+      if (addr == MAP_FAILED) [[unlikely]] throw std::runtime_error("file \""s + strFile.string() + "\" can't mapped"s);
+      if (options.sequential) ::madvise(addr, theSize, MADV_SEQUENTIAL);
+      theData = static_cast<const char*>(addr);
+      }
+   else ::close(fd);
+   }
+
+TMappedFile::~TMappedFile() {
+   if (theData != nullptr) ::munmap(const_cast<char*>(theData), theSize);
+   }
+
+#endif
+
+// --------------------------------------------------------------------
+// my_stream_lines
+// --------------------------------------------------------------------
+
+my_stream_lines::my_stream_lines(std::filesystem::path const& strFile, size_t block_size) :
+                     ifs(strFile, std::ios_base::binary), iBlockSize(std::max<size_t>(1u, block_size)) {
+   if (!ifs.is_open()) [[unlikely]] throw std::runtime_error("file \""s + strFile.string() + "\" can't opened"s);
+   ifs.exceptions(std::ios_base::badbit);
+   theReader = std::jthread([this](std::stop_token token) { Read(token); });
+   }
+
+std::optional<my_lines> my_stream_lines::Next() {
+   // trace events can refer to the lines of the previous block, they are formatted before it's reused
+   if constexpr (boTraceEvents)
+      if (auto* session = TTraceSession::Current(); boDelivered && session != nullptr) session->Drain();
+
+   std::unique_lock lock(theMutex);
+   if (boDelivered) {
+      // the previous block is processed, the reader can fill it again
+      theBlocks[iCurrent].filled = false;
+      iCurrent ^= 1u;
+      boDelivered = false;
+      theCondition.notify_all();
+      }
+
+   theCondition.wait(lock, [this]() { return theBlocks[iCurrent].filled || boFinished; });
+   if (theBlocks[iCurrent].filled) {
+      boDelivered = true;
+      ++iBlocks;
+      return my_lines(theBlocks[iCurrent].content);
+      }
+   if (theError) std::rethrow_exception(theError);
+   return std::nullopt;
+   }
+
+void my_stream_lines::Read(std::stop_token token) {
+   try {
+      std::string carry;   // begin of a line which was cut at the end of the previous block
+      for (size_t slot = 0u; ; ) {
+         {
+         std::unique_lock lock(theMutex);
+         if (!theCondition.wait(lock, token, [this, slot]() { return !theBlocks[slot].filled; })) return;
+         }
+
+         // the block isn't filled, so it's owned by this thread until it is handed over
+         auto& block = theBlocks[slot];
+         block.data.resize(carry.size() + iBlockSize);
+         std::ranges::copy(carry, block.data.begin());
+         ifs.read(block.data.data() + carry.size(), iBlockSize);
+         const size_t iRead  = static_cast<size_t>(ifs.gcount());
+         const size_t iTotal = carry.size() + iRead;
+         const bool   boEof  = iRead < iBlockSize;
+
+         // end of the last complete line, at the end of the file the rest is part of the block
+         const size_t iLast = boEof ? iTotal : std::string_view(block.data.data(), iTotal).rfind('\n') + 1;
+         carry.assign(block.data.data() + iLast, iTotal - iLast);
+
+         if (iLast > 0) {
+            std::unique_lock lock(theMutex);
+            block.content = std::string_view(block.data.data(), iLast);
+            block.filled  = true;
+            theCondition.notify_all();
+            slot ^= 1u;
+            }
+         // else a line longer than the block, continue to read in the same slot
+
+         if (boEof) break;
+         }
+      }
+   catch (...) {
+      std::unique_lock lock(theMutex);
+      theError = std::current_exception();
+      }
+
+   std::unique_lock lock(theMutex);
+   boFinished = true;
+   theCondition.notify_all();
+   }
+
+// --------------------------------------------------------------------
+// THugePageResource
+// --------------------------------------------------------------------
+
+namespace {
+   constexpr size_t huge_page_size = 2u << 20;
+
+   size_t RoundToHugePages(size_t bytes) {
+   #if defined(_WIN32)
+      const size_t page = std::max<size_t>(::GetLargePageMinimum(), 1u);
+   #else
+      const size_t page = huge_page_size;
+   #endif
+      return (bytes + page - 1) / page * page;
+      }
+   }
+
+void* THugePageResource::do_allocate(size_t bytes, size_t alignment) {
+   boHugePages = false;
+   // only blocks of at least half a huge page are worth it, the arena requests big blocks anyway
+   if (bytes >= huge_page_size / 2 && alignment <= huge_page_size) {
+      #if defined(_WIN32)
+         void* p = ::GetLargePageMinimum() > 0 ? ::VirtualAlloc(nullptr, RoundToHugePages(bytes), MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE)
+                                               : nullptr;
+      #elif defined(MAP_HUGETLB)
+         void* p = ::mmap(nullptr, RoundToHugePages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+         if (p == MAP_FAILED) p = nullptr;
+      #else
+         void* p = nullptr;
+      #endif
+      if (p != nullptr) {
+         theHugeBlocks.emplace_back(p);
+         boHugePages = true;
+         return p;
+         }
+      }
+   return ::operator new(bytes, std::align_val_t { alignment });
+   }
+
+void THugePageResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+   if (auto it = std::ranges::find(theHugeBlocks, p); it != theHugeBlocks.end()) {
+      theHugeBlocks.erase(it);
+      #if defined(_WIN32)
+         ::VirtualFree(p, 0, MEM_RELEASE);
+      #elif defined(MAP_HUGETLB)
+         ::munmap(p, RoundToHugePages(bytes));
+      #endif
+      }
+   else ::operator delete(p, bytes, std::align_val_t { alignment });
+   }
+
+// --------------------------------------------------------------------
+// TThreadPool
+// --------------------------------------------------------------------
+
+namespace {
+   /// pool and number of the worker running in this thread, nullptr for other threads
+   thread_local TThreadPool* current_pool   = nullptr;
+   thread_local size_t       current_worker = 0u;
+   }
+
+TThreadPool& TThreadPool::Instance() {
+   static TThreadPool pool(std::max<size_t>(1u, std::thread::hardware_concurrency()) - 1);
+   return pool;
+   }
+
+TThreadPool::TThreadPool(size_t workers) {
+   theQueues.reserve(workers + 1);
+   for (size_t idx = 0; idx <= workers; ++idx) theQueues.emplace_back(std::make_unique<queue_ty>());
+   theWorkers.reserve(workers);
+   for (size_t idx = 0; idx < workers; ++idx)
+      theWorkers.emplace_back([this, idx](std::stop_token token) { Work(token, idx); });
+   }
+
+TThreadPool::~TThreadPool() {
+   for (auto& worker : theWorkers) worker.request_stop();
+   theCondition.notify_all();
+   theWorkers.clear();
+   }
+
+void TThreadPool::Submit(task_ty task) {
+   // workers push to their own deque, all other threads to the shared queue
+   auto& queue = current_pool == this ? *theQueues[current_worker] : *theQueues.back();
+   {
+   std::scoped_lock lock(queue.mutex);
+   queue.tasks.emplace_back(std::move(task));
+   }
+   iPending.fetch_add(1u, std::memory_order_release);
+   std::scoped_lock lock(theMutex);
+   theCondition.notify_one();
+   }
+
+void TThreadPool::SubmitJob(task_ty task) {
+   {
+   std::scoped_lock lock(theJobs.mutex);
+   theJobs.tasks.emplace_back(std::move(task));
+   }
+   iJobs.fetch_add(1u, std::memory_order_release);
+   // a single notification could wake a thread which doesn't take jobs
+   std::scoped_lock lock(theMutex);
+   theCondition.notify_all();
+   }
+
+bool TThreadPool::RunOne(bool boJobs) {
+   auto task = Take(current_pool == this ? current_worker : theQueues.size() - 1);
+   if (!task && boJobs) task = TakeJob();
+   if (!task) return false;
+   (*task)();
+   return true;
+   }
+
+std::optional<TThreadPool::task_ty> TThreadPool::TakeJob() {
+   if (iJobs.load(std::memory_order_acquire) == 0u) return std::nullopt;
+   std::scoped_lock lock(theJobs.mutex);
+   if (theJobs.tasks.empty()) return std::nullopt;
+   auto task = std::move(theJobs.tasks.front());
+   theJobs.tasks.pop_front();
+   iJobs.fetch_sub(1u, std::memory_order_relaxed);
+   return task;
+   }
+
+std::optional<TThreadPool::task_ty> TThreadPool::Take(size_t index) {
+   if (iPending.load(std::memory_order_acquire) == 0u) return std::nullopt;
+
+   auto take = [this](queue_ty& queue, bool newest) -> std::optional<task_ty> {
+      std::scoped_lock lock(queue.mutex);
+      if (queue.tasks.empty()) return std::nullopt;
+      task_ty task;
+      if (newest) {
+         task = std::move(queue.tasks.back());
+         queue.tasks.pop_back();
+         }
+      else {
+         task = std::move(queue.tasks.front());
+         queue.tasks.pop_front();
+         }
+      iPending.fetch_sub(1u, std::memory_order_relaxed);
+      return task;
+      };
+
+   const size_t shared = theQueues.size() - 1;
+   // own deque first (newest task, hot in the cache), then the shared queue, then steal the oldest tasks
+   if (index < shared) if (auto task = take(*theQueues[index], true); task) return task;
+   if (auto task = take(*theQueues[shared], false); task) return task;
+   for (size_t offset = 1; offset <= shared; ++offset) {
+      const size_t victim = (index + offset) % shared;
+      if (victim == index) continue;
+      if (auto task = take(*theQueues[victim], false); task) return task;
+      }
+   return std::nullopt;
+   }
+
+void TThreadPool::Work(std::stop_token token, size_t index) {
+   current_pool   = this;
+   current_worker = index;
+   while (!token.stop_requested()) {
+      // the tasks of the running jobs first, then a new job
+      if (auto task = Take(index); task) (*task)();
+      else if (auto job = TakeJob(); job) (*job)();
+      else {
+         std::unique_lock lock(theMutex);
+         theCondition.wait(lock, token, [this]() {
+            return iPending.load(std::memory_order_acquire) > 0u || iJobs.load(std::memory_order_acquire) > 0u;
+            });
+         }
+      }
+   }
+
+// --------------------------------------------------------------------
+// TRiddleCancellation
+// --------------------------------------------------------------------
+
+TRiddleCancellation::TRiddleCancellation(std::stop_token outer, std::optional<std::chrono::milliseconds> budget) :
+                  theToken(theSource.get_token()), thePrevious(std::exchange(Current(), this)) {
+   if (outer.stop_possible()) theOuter.emplace(outer, forward_stop { theSource });
+   if (budget) {
+      // the watchdog sleeps until the deadline, it's woken and joined when the call ends before
+      theWatchdog = std::jthread([this, deadline = std::chrono::steady_clock::now() + *budget](std::stop_token token) {
+         std::mutex mutex;
+         std::condition_variable_any condition;
+         std::unique_lock lock(mutex);
+         condition.wait_until(lock, token, deadline, []() { return false; });
+         if (!token.stop_requested()) {
+            boBudgetExceeded.store(true, std::memory_order_release);
+            theSource.request_stop();
+            }
+         });
+      }
+   }
+
+TRiddleCancellation::~TRiddleCancellation() {
+   theWatchdog = { };
+   Current() = thePrevious;
+   }
+
+// --------------------------------------------------------------------
+// memory accounting
+// --------------------------------------------------------------------
+
+namespace {
+   size_t UsableSize(void* ptr) {
+      #if defined(_WIN32)
+         return ::_msize(ptr);
+      #elif defined(__APPLE__)
+         return ::malloc_size(ptr);
+      #else
+         return ::malloc_usable_size(ptr);
+      #endif
+      }
+
+   /// only relaxed atomics, the hook must not allocate itself
+   void CountNew(size_t size, size_t usable) {
+      if (auto stats = TAllocationScope::Current(); stats != nullptr) {
+         stats->count.fetch_add(1u, std::memory_order_relaxed);
+         stats->bytes.fetch_add(size, std::memory_order_relaxed);
+         const int64_t live = stats->live.fetch_add(static_cast<int64_t>(usable), std::memory_order_relaxed) + static_cast<int64_t>(usable);
+         for (int64_t peak = stats->peak.load(std::memory_order_relaxed);
+              live > peak && !stats->peak.compare_exchange_weak(peak, live, std::memory_order_relaxed); );
+         }
+      }
+
+   void CountDelete(size_t usable) {
+      if (auto stats = TAllocationScope::Current(); stats != nullptr)
+         stats->live.fetch_sub(static_cast<int64_t>(usable), std::memory_order_relaxed);
+      }
+
+   template <typename alloc_fn>
+   void* Allocate(size_t size, alloc_fn alloc) {
+      for (;;) {
+         if (void* ptr = alloc(size == 0 ? 1 : size); ptr != nullptr) [[likely]] {
+            if (TAllocationScope::Current() != nullptr) CountNew(size, UsableSize(ptr));
+            return ptr;
+            }
+         auto handler = std::get_new_handler();
+         if (handler == nullptr) throw std::bad_alloc();
+         handler();
+         }
+      }
+   }
+
+// the global operators new / delete count into the statistics of the current thread, when there are some.
+// the array and nothrow versions of the standard library call these ones
+void* operator new(std::size_t size) {
+   return Allocate(size, [](size_t bytes) { return std::malloc(bytes); });
+   }
+
+void* operator new[](std::size_t size) {
+   return ::operator new(size);
+   }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+   const auto alignment = static_cast<size_t>(align);
+   #if defined(_WIN32)
+      return Allocate(size, [alignment](size_t bytes) { return ::_aligned_malloc(bytes, alignment); });
+   #else
+      return Allocate(size, [alignment](size_t bytes) { return std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment); });
+   #endif
+   }
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+   return ::operator new(size, align);
+   }
+
+void operator delete(void* ptr) noexcept {
+   if (ptr == nullptr) return;
+   if (TAllocationScope::Current() != nullptr) CountDelete(UsableSize(ptr));
+   std::free(ptr);
+   }
+
+void operator delete[](void* ptr) noexcept { ::operator delete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { ::operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { ::operator delete(ptr); }
+
+void operator delete(void* ptr, std::align_val_t align) noexcept {
+   if (ptr == nullptr) return;
+   #if defined(_WIN32)
+      if (TAllocationScope::Current() != nullptr) CountDelete(::_aligned_msize(ptr, static_cast<size_t>(align), 0));
+      ::_aligned_free(ptr);
+   #else
+      if (TAllocationScope::Current() != nullptr) CountDelete(UsableSize(ptr));
+      std::free(ptr);
+   #endif
+   }
+
+void operator delete[](void* ptr, std::align_val_t align) noexcept { ::operator delete(ptr, align); }
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept { ::operator delete(ptr, align); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t align) noexcept { ::operator delete(ptr, align); }
+
+my_process_memory ProcessMemory() {
+   my_process_memory memory;
+   #if defined(_WIN32)
+      PROCESS_MEMORY_COUNTERS counters { .cb = sizeof(PROCESS_MEMORY_COUNTERS) };
+      if (::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))) {
+         memory.peak_rss     = counters.PeakWorkingSetSize;
+         memory.minor_faults = counters.PageFaultCount;
+         }
+   #else
+      rusage usage { };
+      if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+         #if defined(__APPLE__)
+            memory.peak_rss  = static_cast<uint64_t>(usage.ru_maxrss);          // bytes
+         #else
+            memory.peak_rss  = static_cast<uint64_t>(usage.ru_maxrss) * 1024u;  // kilobytes
+         #endif
+         memory.minor_faults = static_cast<uint64_t>(usage.ru_minflt);
+         memory.major_faults = static_cast<uint64_t>(usage.ru_majflt);
+         }
+   #endif
+   return memory;
+   }
+
+std::string MemoryText(riddle_memory const& memory) {
+   auto MiB = [](uint64_t bytes) { return bytes / (1024.0 * 1024.0); };
+   std::string strText;
+   if (memory.boAllocations)
+      strText = std::format("{} allocations with {:.1f} MiB, peak {:.1f} MiB live, ", memory.allocations,
+                            MiB(memory.bytes), MiB(memory.peak_live));
+   strText += std::format("peak rss {:.1f} MiB, {} page faults ({} major)", MiB(memory.peak_rss),
+                          memory.minor_faults + memory.major_faults, memory.major_faults);
+   return strText;
+   }
+
+// --------------------------------------------------------------------
+// hardware counters
+// --------------------------------------------------------------------
+
+#if defined(__linux__)
+
+TPerfCounters::TPerfCounters() {
+   constexpr uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+   static const std::array<std::tuple<std::optional<uint64_t> my_hardware_counters::*, uint32_t, uint64_t>, 5> events = {{
+      { &my_hardware_counters::cycles,        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+      { &my_hardware_counters::instructions,  PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+      { &my_hardware_counters::l1d_misses,    PERF_TYPE_HW_CACHE, l1d_read_miss },
+      { &my_hardware_counters::llc_misses,    PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+      { &my_hardware_counters::branch_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+      }};
+
+   for (auto const& [member, type, config] : events) {
+      perf_event_attr attr { };
+      attr.size           = sizeof(perf_event_attr);
+      attr.type           = type;
+      attr.config         = config;
+      attr.disabled       = theEvents.empty() ? 1 : 0;   // the group is enabled with its leader
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      const int group = theEvents.empty() ? -1 : theEvents.front().second;
+      const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC));
+      if (fd >= 0) theEvents.emplace_back(member, fd);
+      else if (theEvents.empty()) {
+         // without cycles as leader there is no group, the other counters are missing too
+         const int error = errno;
+         strError = std::format("perf_event_open failed: {}{}", std::strerror(error),
+                                error == EACCES || error == EPERM ? " (see /proc/sys/kernel/perf_event_paranoid)" : "");
+         return;
+         }
+      // other counters the cpu doesn't support (e.g. in a virtual machine) are only missing
+      }
+   }
+
+TPerfCounters::~TPerfCounters() {
+   for (auto const& [member, fd] : theEvents) ::close(fd);
+   }
+
+void TPerfCounters::Start() {
+   if (theEvents.empty()) return;
+   ::ioctl(theEvents.front().second, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+   ::ioctl(theEvents.front().second, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+   }
+
+my_hardware_counters TPerfCounters::Stop() {
+   my_hardware_counters counters { .strError = strError };
+   if (theEvents.empty()) return counters;
+   ::ioctl(theEvents.front().second, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+   // nr, time_enabled, time_running, values in the order of the group
+   std::vector<uint64_t> data(3 + theEvents.size());
+   const auto size = static_cast<ssize_t>(data.size() * sizeof(uint64_t));
+   if (::read(theEvents.front().second, data.data(), size) != size || data[0] != theEvents.size()) {
+      counters.strError = "counters of the group couldn't read";
+      return counters;
+      }
+   // more counters than the cpu has, the kernel multiplexes them and the values are extrapolated
+   const double scale = data[2] > 0 ? static_cast<double>(data[1]) / static_cast<double>(data[2]) : 0.0;
+   for (size_t i = 0; auto const& [member, fd] : theEvents)
+      counters.*member = static_cast<uint64_t>(static_cast<double>(data[3 + i++]) * scale);
+   return counters;
+   }
+
+#else
+
+TPerfCounters::TPerfCounters() : strError("hardware counters are only supported on linux") { }
+TPerfCounters::~TPerfCounters() = default;
+void TPerfCounters::Start() { }
+my_hardware_counters TPerfCounters::Stop() { return { .strError = strError }; }
+
+#endif
+
+std::string HardwareCountersText(my_hardware_counters const& counters) {
+   if (!counters.Valid()) return std::format("no hardware counters, {}", counters.strError);
+   auto value = [](std::optional<uint64_t> const& counter) { return counter ? std::format("{:.3g}", static_cast<double>(*counter)) : "n/a"s; };
+   auto ipc   = counters.IPC();
+   return std::format("{} cycles, {} instructions, IPC {}, {} L1d misses, {} LLC misses, {} branch misses",
+                      value(counters.cycles), value(counters.instructions), ipc ? std::format("{:.2f}", *ipc) : "n/a"s,
+                      value(counters.l1d_misses), value(counters.llc_misses), value(counters.branch_misses));
+   }
+
+// --------------------------------------------------------------------
+// phases of a riddle
+// --------------------------------------------------------------------
+
+TPhaseRecorder::TPhaseRecorder() : theStart(std::chrono::steady_clock::now()), thePrevious(Current()) {
+   theThreads.emplace_back(std::this_thread::get_id());
+   Current() = this;
+   }
+
+TPhaseRecorder::~TPhaseRecorder() {
+   Current() = thePrevious;
+   }
+
+void TPhaseRecorder::Add(riddle_phase&& phase) {
+   std::scoped_lock lock(theMutex);
+   thePhases.emplace_back(std::move(phase));
+   }
+
+void TPhaseRecorder::Count(std::string_view name, int64_t value) {
+   std::scoped_lock lock(theMutex);
+   if (auto it = std::ranges::find(theCounters, name, &riddle_counter::name); it != theCounters.end()) it->value += value;
+   else theCounters.emplace_back(std::string { name }, value);
+   }
+
+uint32_t TPhaseRecorder::ThreadIndex() {
+   const auto id = std::this_thread::get_id();
+   std::scoped_lock lock(theMutex);
+   auto it = std::ranges::find(theThreads, id);
+   if (it == theThreads.end()) it = theThreads.insert(theThreads.end(), id);
+   return static_cast<uint32_t>(std::distance(theThreads.begin(), it));
+   }
+
+void TPhaseRecorder::MoveTo(riddle_result& result) {
+   std::scoped_lock lock(theMutex);
+   std::ranges::sort(thePhases, [](riddle_phase const& lhs, riddle_phase const& rhs) {
+      return std::tie(lhs.start, lhs.depth) < std::tie(rhs.start, rhs.depth);
+      });
+   std::ranges::move(thePhases, std::back_inserter(result.phases));
+   std::ranges::move(theCounters, std::back_inserter(result.counters));
+   thePhases.clear();
+   theCounters.clear();
+   }
+
+// --------------------------------------------------------------------
+// trace rings
+// --------------------------------------------------------------------
+
+namespace {
+   std::atomic<uint64_t> trace_sessions = 0u;
+   }
+
+TTraceSession::TTraceSession(std::ostream& out) : theOut(out), theOutput(TCaptureBuffer::Current()),
+                  iId(trace_sessions.fetch_add(1u, std::memory_order_relaxed) + 1u), thePrevious(std::exchange(Current(), this)) {
+   // the events appear while the riddle runs, the consumer writes into the same captured output as the run
+   theConsumer = std::jthread([this](std::stop_token token) {
+      TOutputCapture capture(theOutput);
+      std::mutex mutex;
+      std::condition_variable_any wakeup;
+      while (!token.stop_requested()) {
+         {
+         std::unique_lock lock(mutex);
+         wakeup.wait_for(lock, token, std::chrono::milliseconds(20), []() { return false; });
+         }
+         Drain();
+         }
+      });
+   }
+
+TTraceSession::~TTraceSession() {
+   theConsumer.request_stop();
+   if (theConsumer.joinable()) theConsumer.join();
+   Drain();
+   Current() = thePrevious;
+   }
+
+void TTraceSession::Drain() {
+   std::scoped_lock drain_lock(theDrainMutex);
+   std::vector<TTraceRing*> rings;
+   {
+   std::scoped_lock lock(theRingMutex);
+   for (auto const& [thread, ring] : theRings) rings.emplace_back(ring.get());
+   }
+   for (auto* ring : rings) ring->Drain(theOut);
+   theOut.flush();
+   }
+
+TTraceRing& TTraceSession::Ring() {
+   // the last ring of the thread is cached, a worker can run tasks of several sessions in turn
+   thread_local uint64_t    cached_id   = 0u;
+   thread_local TTraceRing* cached_ring = nullptr;
+   if (cached_id == iId) return *cached_ring;
+
+   std::scoped_lock lock(theRingMutex);
+   const auto thread = std::this_thread::get_id();
+   auto it = std::ranges::find(theRings, thread, [](auto const& entry) { return entry.first; });
+   if (it == theRings.end()) it = theRings.emplace(theRings.end(), thread, std::make_unique<TTraceRing>());
+   cached_id   = iId;
+   cached_ring = it->second.get();
+   return *cached_ring;
+   }
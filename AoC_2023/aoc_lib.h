@@ -12,8 +12,34 @@
 #include <filesystem>
 #include <atomic>
 #include <concepts>
+#include <memory>
+#include <ranges>
+#include <bit>
+#include <algorithm>
+#include <thread>
+#include <exception>
+#include <array>
+#include <span>
+#include <limits>
+#include <format>
+#include <tuple>
+#include <utility>
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+#include <memory_resource>
+#include <functional>
+#include <deque>
+#include <cstring>
+#include <cstddef>
+#include <chrono>
+#include <variant>
+#include <new>
 
-#include <QCoreApplication>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #include <emmintrin.h>
+   #define AOC_SSE2
+#endif
 
 
 using namespace std::literals::string_literals;
@@ -24,10 +50,6 @@ const bool boWithTrace = true;
 
 enum EPart_of_Riddle : uint8_t { Part1 = 1, Part2 = 2 };
 
-inline void Processing_Events() {
-   QCoreApplication::processEvents();
-   }
-
 inline std::ostream& operator << (std::ostream& out, EPart_of_Riddle const& part) {
    switch (part) {
       case EPart_of_Riddle::Part1: out << "1st part"; break;
@@ -77,23 +99,18 @@ concept my_integral_ty = std::is_integral_v<ty> && !std::is_same_v<ty, bool>;
 template <my_integral_ty ty>
 ty toInt(std::string_view str) {
    static auto constexpr toString = [](std::string_view str) { return std::string{ str.data(), str.size() }; };
-   std::size_t pos{};
-   if constexpr (std::is_same_v<ty, long long>) return stoll(toString(str), &pos);
-   else if constexpr (std::is_same_v<ty, unsigned long long>) return std::stoull(toString(str), &pos);
-   else {
-      ty result{};
-      auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
+   ty result{};
+   auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
 
-      if (ptr == str.data() + str.size()) [[likely]] {
-         switch (ec) {
-            case std::errc(): return result;
-            case std::errc::invalid_argument:  throw std::invalid_argument("The given argument '"s + toString(str) + "' is invalid"s);
-            case std::errc::result_out_of_range: throw std::out_of_range("The result for '"s + toString(str) + "' isn't in range that can be represented for int values."s);
-            default: throw std::runtime_error("unexpected eror in method from_chars for input '"s + toString(str) + "'."s);
-            }
+   if (ptr == str.data() + str.size()) [[likely]] {
+      switch (ec) {
+         case std::errc(): return result;
+         case std::errc::invalid_argument:  throw std::invalid_argument("The given argument '"s + toString(str) + "' is invalid"s);
+         case std::errc::result_out_of_range: throw std::out_of_range("The result for '"s + toString(str) + "' isn't in range that can be represented for int values."s);
+         default: throw std::runtime_error("unexpected eror in method from_chars for input '"s + toString(str) + "'."s);
          }
-      else throw std::invalid_argument("Not all characters in '"s + toString(str) + "' could be converted."s);
       }
+   else throw std::invalid_argument("Not all characters in '"s + toString(str) + "' could be converted."s);
    }
 
 template <my_integral_ty ty>
@@ -101,6 +118,618 @@ ty toInt(std::string const& str) {
    return toInt<ty>(std::string_view{ str.data(), str.size() });
    }
 
+/// unsigned 128 bit value for answers which don't fit in 64 bit, only to store and to print them
+struct my_uint128 {
+   uint64_t high = 0u;
+   uint64_t low  = 0u;
+
+   friend bool operator == (my_uint128 const&, my_uint128 const&) = default;
+   friend auto operator <=> (my_uint128 const&, my_uint128 const&) = default;
+   };
+
+/// decimal text of the value, implemented in aoc_lib.cpp
+std::string to_String(my_uint128 const& value);
+
+/// answer of a riddle, std::monostate when the riddle has no answer (not solved or an error)
+using riddle_answer_ty = std::variant<std::monostate, int64_t, my_uint128, std::string>;
+
+/// duration of a part of the solution, e.g. read, parse or simulate (TPhaseTimer)
+struct riddle_phase {
+   std::string              name;
+   std::chrono::nanoseconds time  { 0 };
+   std::chrono::nanoseconds start { 0 };   ///< offset to the start of the run
+   uint32_t                 depth  = 0;    ///< nesting of the phases in the thread, 0 for the outer phases
+   uint32_t                 thread = 0;    ///< index of the thread in the run, 0 is the calling thread
+   };
+
+/// counter of the solver, e.g. steps or states
+struct riddle_counter {
+   std::string name;
+   int64_t     value = 0;
+   };
+
+/// result of a riddle. the riddles don't write their answer, the text is created with Render() outside
+/// of the measured call. the containers use the global heap, the result outlives the arena of the riddle
+struct riddle_result {
+   int                         day  = 0;
+   int                         part = 0;
+   riddle_answer_ty            answer;
+   std::string                 strLabel = "solution = {}";   ///< text for the answer, {} is replaced with the answer
+   std::vector<riddle_phase>   phases;
+   std::vector<riddle_counter> counters;
+
+   bool HasAnswer() const { return !std::holds_alternative<std::monostate>(answer); }
+
+   template <my_integral_ty ty>
+   void Answer(ty value) {
+      if constexpr (std::is_unsigned_v<ty>) {
+         if (value > static_cast<std::make_unsigned_t<int64_t>>(std::numeric_limits<int64_t>::max())) {
+            answer = my_uint128 { 0u, static_cast<uint64_t>(value) };
+            return;
+            }
+         }
+      answer = static_cast<int64_t>(value);
+      }
+
+   void Answer(my_uint128 const& value) { answer = value; }
+   void Answer(std::string value) { answer = std::move(value); }
+
+   void Counter(std::string name, int64_t value) { counters.emplace_back(std::move(name), value); }
+   };
+
+/// answer as text, empty without answer
+std::string AnswerText(riddle_result const& result);
+/// text of the result like the riddles have written it before, implemented in aoc_lib.cpp
+std::string Render(riddle_result const& result);
+/// phases and counters of the result as Chrome / Perfetto trace events (JSON), times in microseconds
+void WriteChromeTrace(std::ostream& out, riddle_result const& result);
+/// text with the escape sequences of a JSON string
+std::string EscapeJson(std::string_view text);
+/// 64 bit hash of the bytes (XXH64), fast enough for hashing whole inputs, implemented in aoc_lib.cpp
+uint64_t HashBytes(std::string_view data, uint64_t seed = 0);
+
+/// options for the memory arena of a riddle
+struct my_arena_options {
+   bool   huge_pages   = false;     ///< request the blocks of the arena as huge / large pages, with fallback
+   size_t initial_size = 1u << 20;  ///< size of the first block, the following blocks grow geometric
+   };
+
+/// settings of the arena for every call of a riddle, normal runs, benchmarks and batches measure the same
+inline constexpr my_arena_options riddle_arena_options { .huge_pages = true };
+
+/// upstream for the riddle arena, gets its memory as huge pages (MAP_HUGETLB / MEM_LARGE_PAGES) and uses
+/// the normal heap when the system can't deliver them. implemented in aoc_lib.cpp
+class THugePageResource : public std::pmr::memory_resource {
+   public:
+      /// true when the last allocation could use huge pages
+      bool UsedHugePages() const { return boHugePages; }
+
+   private:
+      void* do_allocate(size_t bytes, size_t alignment) override;
+      void  do_deallocate(void* p, size_t bytes, size_t alignment) override;
+      bool  do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+
+      std::vector<void*> theHugeBlocks;   ///< blocks from the system with huge pages, all others are from the heap
+      bool               boHugePages = false;
+   };
+
+namespace my_arena_detail {
+   inline thread_local std::pmr::memory_resource* current_resource = nullptr;
+   }
+
+/// memory resource of the riddle running in this thread, the default resource outside of a riddle
+inline std::pmr::memory_resource* RiddleResource() {
+   return my_arena_detail::current_resource != nullptr ? my_arena_detail::current_resource : std::pmr::get_default_resource();
+   }
+
+/// arena for all allocations of one riddle. a pool reuses freed blocks, the monotonic buffer below
+/// releases everything in one step when the arena is destroyed. while it exists, the arena is the
+/// RiddleResource() of the thread which created it. the arena isn't synchronized, containers using it
+/// must not grow in other threads (map_reduce creates the accumulators in its workers)
+class TRiddleArena {
+   public:
+      TRiddleArena(my_arena_options const& options = riddle_arena_options) :
+                  theMonotonic(options.initial_size, options.huge_pages ? static_cast<std::pmr::memory_resource*>(&theHugePages)
+                                                                        : std::pmr::new_delete_resource()),
+                  thePool(&theMonotonic), thePrevious(my_arena_detail::current_resource) {
+         my_arena_detail::current_resource = &thePool;
+         }
+
+      TRiddleArena(TRiddleArena const&) = delete;
+      TRiddleArena(TRiddleArena&&) = delete;
+      ~TRiddleArena() { my_arena_detail::current_resource = thePrevious; }
+
+      TRiddleArena& operator = (TRiddleArena const&) = delete;
+      TRiddleArena& operator = (TRiddleArena&&) = delete;
+
+      std::pmr::memory_resource* Resource() { return &thePool; }
+      bool UsedHugePages() const { return theHugePages.UsedHugePages(); }
+
+   private:
+      THugePageResource                     theHugePages;
+      std::pmr::monotonic_buffer_resource   theMonotonic;
+      std::pmr::unsynchronized_pool_resource thePool;
+      std::pmr::memory_resource*            thePrevious;
+   };
+
+/// polymorphic allocator which takes the RiddleResource() of the current thread when it's default
+/// constructed, so std::ranges::to<my_vector<ty>>() and copies of containers use the riddle arena
+template <typename ty>
+class my_allocator : public std::pmr::polymorphic_allocator<ty> {
+   public:
+      using std::pmr::polymorphic_allocator<ty>::polymorphic_allocator;
+
+      my_allocator() noexcept : std::pmr::polymorphic_allocator<ty>(RiddleResource()) { }
+      template <typename other_ty>
+      my_allocator(my_allocator<other_ty> const& other) noexcept : std::pmr::polymorphic_allocator<ty>(other.resource()) { }
+
+      my_allocator select_on_container_copy_construction() const { return my_allocator(); }
+   };
+
+template <typename ty>
+using my_vector = std::vector<ty, my_allocator<ty>>;
+
+/// vector with a fixed inline capacity, the values are moved to the heap only when more than N
+/// elements are added. intended for small, trivially copyable values like the numbers of a line
+template <typename ty, size_t N>
+   requires std::is_trivially_copyable_v<ty>
+class my_small_vector {
+   public:
+      using value_type     = ty;
+      using iterator       = ty*;
+      using const_iterator = ty const*;
+
+      my_small_vector() = default;
+
+      void push_back(ty value) {
+         if (!theHeap.empty()) theHeap.push_back(value);
+         else if (theSize < N) theInline[theSize] = value;
+         else {
+            theHeap.reserve(2 * N);
+            theHeap.assign(theInline.begin(), theInline.end());
+            theHeap.push_back(value);
+            }
+         ++theSize;
+         }
+
+      void clear() { theSize = 0u; theHeap.clear(); }
+
+      size_t size() const { return theSize; }
+      bool   empty() const { return theSize == 0u; }
+
+      ty*       data() { return theHeap.empty() ? theInline.data() : theHeap.data(); }
+      ty const* data() const { return theHeap.empty() ? theInline.data() : theHeap.data(); }
+
+      ty&       operator [](size_t pos) { return data()[pos]; }
+      ty const& operator [](size_t pos) const { return data()[pos]; }
+
+      iterator       begin() { return data(); }
+      iterator       end() { return data() + theSize; }
+      const_iterator begin() const { return data(); }
+      const_iterator end() const { return data() + theSize; }
+
+   private:
+      std::array<ty, N> theInline;
+      my_vector<ty>     theHeap;
+      size_t            theSize = 0u;
+   };
+
+/// position of the next digit at or behind pos in text or text.size(), SSE2 checks 16 characters at once
+inline size_t FindDigit(std::string_view text, size_t pos) {
+   #if defined(AOC_SSE2)
+      const __m128i below = _mm_set1_epi8('0' - 1);
+      const __m128i above = _mm_set1_epi8('9' + 1);
+      for (; pos + 16 <= text.size(); pos += 16) {
+         __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + pos));
+         __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(chunk, below), _mm_cmplt_epi8(chunk, above));
+         if (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(digits)); mask != 0)
+            return pos + std::countr_zero(mask);
+         }
+   #endif
+   for (; pos < text.size(); ++pos) if (text[pos] >= '0' && text[pos] <= '9') return pos;
+   return text.size();
+   }
+
+/// call found(ty) for every integer in the text, without allocation. a '-' directly in front of the
+/// digits, but not behind a digit, is the sign. values outside of the range of ty throw std::out_of_range.
+template <my_integral_ty ty, typename func_ty>
+void ForEachInteger(std::string_view text, func_ty&& found) {
+   using unsigned_ty = std::make_unsigned_t<ty>;
+   static constexpr unsigned long long max_value = static_cast<unsigned long long>(std::numeric_limits<ty>::max());
+
+   auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+
+   for (size_t pos = FindDigit(text, 0u); pos < text.size(); pos = FindDigit(text, pos)) {
+      const bool negative = pos > 0 && text[pos - 1] == '-' && (pos == 1 || !isDigit(text[pos - 2]));
+      if constexpr (std::is_unsigned_v<ty>) {
+         if (negative) throw std::out_of_range(std::format("negative value in \"{}\" for an unsigned type", text));
+         }
+      const unsigned long long limit = negative ? max_value + 1 : max_value;
+
+      unsigned long long value = 0u;
+      for (; pos < text.size() && isDigit(text[pos]); ++pos) {
+         const unsigned digit = static_cast<unsigned>(text[pos] - '0');
+         if (value > (limit - digit) / 10) [[unlikely]]
+            throw std::out_of_range(std::format("value in \"{}\" isn't in the range of the type", text));
+         value = value * 10 + digit;
+         }
+      found(negative ? static_cast<ty>(static_cast<unsigned_ty>(0u - value)) : static_cast<ty>(value));
+      }
+   }
+
+/// write all integers of the text to the preallocated span and return the count,
+/// throws std::out_of_range when the text contains more values than the span can take
+template <my_integral_ty ty>
+size_t ExtractIntegers(std::string_view text, std::span<ty> values) {
+   size_t iCount = 0u;
+   ForEachInteger<ty>(text, [&](ty value) {
+      if (iCount == values.size()) throw std::out_of_range(std::format("more than {} integers in \"{}\"", values.size(), text));
+      values[iCount++] = value;
+      });
+   return iCount;
+   }
+
+/// append all integers of the text to a container (my_small_vector, reserved std::vector, ...)
+template <typename container_ty>
+   requires my_integral_ty<typename container_ty::value_type>
+container_ty& ExtractIntegers(std::string_view text, container_ty& values) {
+   ForEachInteger<typename container_ty::value_type>(text, [&values](auto value) { values.push_back(value); });
+   return values;
+   }
+
+/// string literal as template argument, used for the compile time patterns
+template <size_t N>
+struct my_fixed_string {
+   char value[N] { };
+   constexpr my_fixed_string(const char (&str)[N]) { std::copy_n(str, N, value); }
+   constexpr std::string_view view() const { return { value, N - 1 }; }
+   };
+
+/// kinds of elements in a pattern: literal text, a run of spaces (matches zero or more spaces / tabs)
+/// and the captures {} / {name} (text), {N} (exact N characters), {int} and {uint}
+enum class EPatternKind : uint8_t { literal, space, text, fixed, integer, unsigned_integer };
+
+struct my_pattern_token {
+   EPatternKind     kind  = EPatternKind::literal;
+   std::string_view part  = { };   ///< literal text or name of the capture, view into the pattern
+   size_t           width = 0u;    ///< count of characters for fixed captures
+   };
+
+namespace my_pattern_detail {
+
+   constexpr bool IsSpace(char c) { return c == ' ' || c == '\t'; }
+   constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+   constexpr bool IsCapture(EPatternKind kind) { return kind != EPatternKind::literal && kind != EPatternKind::space; }
+
+   /// split the pattern in tokens, errors throw, so an invalid pattern doesn't compile
+   template <typename func_ty>
+   constexpr void Tokenize(std::string_view pattern, func_ty&& found) {
+      for (size_t pos = 0u; pos < pattern.size(); ) {
+         if (IsSpace(pattern[pos])) {
+            while (pos < pattern.size() && IsSpace(pattern[pos])) ++pos;
+            found(my_pattern_token { EPatternKind::space });
+            }
+         else if (pattern[pos] == '{') {
+            const size_t close = pattern.find('}', pos);
+            if (close == std::string_view::npos) throw std::invalid_argument("missing '}' in pattern");
+            const std::string_view content = pattern.substr(pos + 1, close - pos - 1);
+            const size_t sep = content.find(':');
+            const std::string_view spec = sep == std::string_view::npos ? content : content.substr(sep + 1);
+
+            my_pattern_token token { EPatternKind::text, sep == std::string_view::npos ? std::string_view { } : content.substr(0, sep) };
+            if (spec.empty()) token.kind = EPatternKind::text;
+            else if (spec == "int") token.kind = EPatternKind::integer;
+            else if (spec == "uint") token.kind = EPatternKind::unsigned_integer;
+            else if (std::ranges::all_of(spec, IsDigit)) {
+               token.kind = EPatternKind::fixed;
+               for (char c : spec) token.width = token.width * 10 + (c - '0');
+               if (token.width == 0) throw std::invalid_argument("fixed capture without characters in pattern");
+               }
+            else if (sep == std::string_view::npos) token.part = spec;   // {name} is a named text capture
+            else throw std::invalid_argument("unknown format of a capture in pattern");
+            found(token);
+            pos = close + 1;
+            }
+         else {
+            size_t end = pos;
+            while (end < pattern.size() && !IsSpace(pattern[end]) && pattern[end] != '{') ++end;
+            found(my_pattern_token { EPatternKind::literal, pattern.substr(pos, end - pos) });
+            pos = end;
+            }
+         }
+      }
+
+   constexpr size_t CountTokens(std::string_view pattern) {
+      size_t iCount = 0u;
+      Tokenize(pattern, [&iCount](my_pattern_token const&) { ++iCount; });
+      return iCount;
+      }
+
+   template <size_t N>
+   constexpr std::array<my_pattern_token, N> Tokens(std::string_view pattern) {
+      std::array<my_pattern_token, N> tokens { };
+      size_t idx = 0u;
+      Tokenize(pattern, [&](my_pattern_token const& token) { tokens[idx++] = token; });
+      // a text capture needs a literal or spaces behind it, otherwise the end is ambiguous
+      for (size_t i = 0u; i + 1 < N; ++i)
+         if (tokens[i].kind == EPatternKind::text && IsCapture(tokens[i + 1].kind))
+            throw std::invalid_argument("text capture directly followed by another capture in pattern");
+      return tokens;
+      }
+
+   template <EPatternKind kind>
+   using capture_ty = std::conditional_t<kind == EPatternKind::integer, long long,
+                         std::conditional_t<kind == EPatternKind::unsigned_integer, unsigned long long, std::string_view>>;
+
+   } // end of namespace my_pattern_detail
+
+/// pattern for the lines of an input, parsed at compile time, e.g. my_pattern<"{3} = ({3}, {3})"> or
+/// my_pattern<"{cards:5} {bid:uint}">. match() checks the complete line and returns the captures as
+/// tuple (std::string_view for text, long long / unsigned long long for numbers) without allocation.
+/// literals must match exactly, spaces in the pattern match zero or more spaces or tabs, a text
+/// capture ends at the next literal (trailing spaces removed) or at the next space before a capture.
+template <my_fixed_string pattern>
+class my_pattern {
+      static constexpr std::string_view pattern_text = pattern.view();
+      static constexpr size_t token_count = my_pattern_detail::CountTokens(pattern_text);
+      static constexpr std::array<my_pattern_token, token_count> tokens = my_pattern_detail::Tokens<token_count>(pattern_text);
+
+      static constexpr size_t capture_count = std::ranges::count_if(tokens, [](auto const& token) {
+                                                                      return my_pattern_detail::IsCapture(token.kind); });
+
+      /// index of the capture for the token I
+      static constexpr size_t CaptureOf(size_t token) {
+         return std::ranges::count_if(tokens.begin(), tokens.begin() + token, [](auto const& t) { return my_pattern_detail::IsCapture(t.kind); });
+         }
+
+      static constexpr std::array<size_t, capture_count> capture_tokens = []() {
+         std::array<size_t, capture_count> ret { };
+         for (size_t i = 0u, c = 0u; i < token_count; ++i)
+            if (my_pattern_detail::IsCapture(tokens[i].kind)) ret[c++] = i;
+         return ret;
+         }();
+
+      template <size_t... I>
+      static auto MakeResult(std::index_sequence<I...>) -> std::tuple<my_pattern_detail::capture_ty<tokens[capture_tokens[I]].kind>...>;
+
+   public:
+      using result_ty = decltype(MakeResult(std::make_index_sequence<capture_count>{}));
+
+      static constexpr std::optional<result_ty> match(std::string_view input) {
+         result_ty result { };
+         size_t pos = 0u;
+         if (Steps(input, pos, result, std::make_index_sequence<token_count>{}) && pos == input.size()) return result;
+         else return std::nullopt;
+         }
+
+      /// index of the capture with the name in the result
+      template <my_fixed_string name>
+      static constexpr size_t index() {
+         constexpr size_t idx = []() {
+            for (size_t c = 0u; c < capture_count; ++c) if (tokens[capture_tokens[c]].part == name.view()) return c;
+            return capture_count;
+            }();
+         static_assert(idx < capture_count, "there is no capture with this name in the pattern");
+         return idx;
+         }
+
+      template <my_fixed_string name>
+      static constexpr auto const& get(result_ty const& result) { return std::get<index<name>()>(result); }
+
+   private:
+      template <size_t... I>
+      static constexpr bool Steps(std::string_view input, size_t& pos, result_ty& result, std::index_sequence<I...>) {
+         return (Step<I>(input, pos, result) && ...);
+         }
+
+      template <size_t I>
+      static constexpr bool Step(std::string_view input, size_t& pos, result_ty& result) {
+         constexpr my_pattern_token token = tokens[I];
+         if constexpr (token.kind == EPatternKind::literal) {
+            if (!input.substr(pos).starts_with(token.part)) return false;
+            pos += token.part.size();
+            return true;
+            }
+         else if constexpr (token.kind == EPatternKind::space) {
+            while (pos < input.size() && my_pattern_detail::IsSpace(input[pos])) ++pos;
+            return true;
+            }
+         else {
+            auto& capture = std::get<CaptureOf(I)>(result);
+            if constexpr (token.kind == EPatternKind::fixed) {
+               if (input.size() - pos < token.width) return false;
+               capture = input.substr(pos, token.width);
+               pos += token.width;
+               return true;
+               }
+            else if constexpr (token.kind == EPatternKind::text) {
+               constexpr size_t next = I + 1 < token_count && tokens[I + 1].kind == EPatternKind::space ? I + 2 : I + 1;
+               size_t end = input.size();
+               if constexpr (next < token_count && tokens[next].kind == EPatternKind::literal) {
+                  end = input.find(tokens[next].part, pos);
+                  if (end == std::string_view::npos) return false;
+                  }
+               else if constexpr (next < token_count) {
+                  end = pos;
+                  while (end < input.size() && !my_pattern_detail::IsSpace(input[end])) ++end;
+                  }
+               capture = input.substr(pos, end - pos);
+               if constexpr (next != I + 1)
+                  while (!capture.empty() && my_pattern_detail::IsSpace(capture.back())) capture.remove_suffix(1);
+               pos = end;
+               return true;
+               }
+            else {
+               using value_ty = std::remove_cvref_t<decltype(capture)>;
+               bool negative = false;
+               if constexpr (token.kind == EPatternKind::integer)
+                  if (pos < input.size() && input[pos] == '-') { negative = true; ++pos; }
+               const unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<value_ty>::max()) + (negative ? 1u : 0u);
+               const size_t start = pos;
+               unsigned long long value = 0u;
+               for (; pos < input.size() && my_pattern_detail::IsDigit(input[pos]); ++pos) {
+                  const unsigned digit = static_cast<unsigned>(input[pos] - '0');
+                  if (value > (limit - digit) / 10) return false;
+                  value = value * 10 + digit;
+                  }
+               if (pos == start) return false;
+               capture = static_cast<value_ty>(negative ? 0u - value : value);
+               return true;
+               }
+            }
+         }
+   };
+
+/// compile time switch for the trace events, compile with AOC_TRACE=0 to remove all TraceEvent calls
+#if !defined(AOC_TRACE)
+   #define AOC_TRACE 1
+#endif
+constexpr bool boTraceEvents = AOC_TRACE != 0;
+
+/// recorded trace event, the formatter of the event type and a copy of the raw arguments
+struct my_trace_record {
+   static constexpr size_t max_args_size = 48u;
+   void (*format)(std::ostream&, std::byte const*) = nullptr;
+   alignas(std::max_align_t) std::array<std::byte, max_args_size> args;
+   };
+
+/// ring buffer for the trace events of one thread in a TTraceSession, lock free with one producer
+/// (the owning thread) and one consumer at a time (TTraceSession::Drain). Push fails when the ring is full
+class TTraceRing {
+   public:
+      static constexpr size_t capacity = 1u << 14;
+
+      bool Push(my_trace_record const& record) {
+         const size_t head = iHead.load(std::memory_order_relaxed);
+         if (head - iTail.load(std::memory_order_acquire) >= capacity) [[unlikely]] return false;
+         // memcpy creates the arguments in the slots of the record again
+         std::memcpy(static_cast<void*>(&theRecords[head % capacity]), &record, sizeof(my_trace_record));
+         iHead.store(head + 1, std::memory_order_release);
+         return true;
+         }
+
+      /// format and remove all recorded events
+      void Drain(std::ostream& out) {
+         const size_t head = iHead.load(std::memory_order_acquire);
+         for (size_t tail = iTail.load(std::memory_order_relaxed); tail != head; ++tail) {
+            auto const& record = theRecords[tail % capacity];
+            record.format(out, record.args.data());
+            iTail.store(tail + 1, std::memory_order_release);
+            }
+         }
+
+   private:
+      std::array<my_trace_record, capacity> theRecords;
+      alignas(64) std::atomic<size_t>       iHead = 0u;
+      alignas(64) std::atomic<size_t>       iTail = 0u;
+   };
+
+struct my_captured_output;
+
+/// trace events of one run of a riddle. every thread of the run (TTaskGroup passes the session on) records
+/// into its own ring, a consumer thread formats the rings into the output while the riddle runs. a thread
+/// with a full ring drains the rings itself, so no event is lost. the destructor formats the rest, the
+/// session must end before the input the events refer to. implemented in aoc_lib.cpp
+class TTraceSession {
+   public:
+      TTraceSession(std::ostream& out);
+      TTraceSession(TTraceSession const&) = delete;
+      ~TTraceSession();
+
+      TTraceSession& operator = (TTraceSession const&) = delete;
+
+      /// format all recorded events of the session (in the order of each thread), one thread at a time
+      void Drain();
+      /// ring of the calling thread, created with the first event of the thread in this session
+      TTraceRing& Ring();
+
+      /// session of the calling thread, nullptr outside of a traced run
+      static TTraceSession*& Current() {
+         static thread_local TTraceSession* current = nullptr;
+         return current;
+         }
+
+   private:
+      std::ostream&                                      theOut;
+      my_captured_output*                                theOutput;   ///< capture of the creating thread, used by the consumer
+      uint64_t                                           iId;         ///< unique, the threads cache their ring with it
+      std::mutex                                         theRingMutex;
+      std::vector<std::pair<std::thread::id, std::unique_ptr<TTraceRing>>> theRings;
+      std::mutex                                         theDrainMutex;
+      TTraceSession*                                     thePrevious;
+      std::jthread                                       theConsumer;   ///< last member
+   };
+
+namespace my_trace_detail {
+   /// offsets of the arguments in the record, each argument in its own slot with the alignment of its type.
+   /// the last element is the size of all slots
+   template <typename... args_ty>
+   constexpr std::array<size_t, sizeof...(args_ty) + 1> Slots() {
+      std::array<size_t, sizeof...(args_ty) + 1> offsets { };
+      size_t offset = 0u, idx = 0u;
+      ((offset = (offset + alignof(args_ty) - 1) / alignof(args_ty) * alignof(args_ty), offsets[idx++] = offset, offset += sizeof(args_ty)), ...);
+      offsets[idx] = offset;
+      return offsets;
+      }
+
+   template <my_fixed_string format, typename... args_ty, size_t... idx>
+   void FormatSlots(std::ostream& out, std::byte const* data, std::index_sequence<idx...>) {
+      static constexpr auto slots = Slots<args_ty...>();
+      out << std::vformat(format.view(), std::make_format_args(*std::launder(reinterpret_cast<args_ty const*>(data + slots[idx]))...));
+      }
+
+   template <my_fixed_string format, typename... args_ty>
+   void Format(std::ostream& out, std::byte const* data) {
+      FormatSlots<format, args_ty...>(out, data, std::index_sequence_for<args_ty...> { });
+      }
+   }
+
+/// record a trace event with a compile time format (std::format syntax), e.g. TraceEvent<"draw: {}\n">(draw).
+/// in a TTraceSession only the arguments are copied into the ring of the thread and formatted later, without
+/// a session the event is written directly to std::cerr. the arguments must be trivially copyable, string_views
+/// must stay valid until the end of the session (the input does). without AOC_TRACE the call is removed completely
+template <my_fixed_string format, typename... args_ty>
+inline void TraceEvent(args_ty const&... args) {
+   if constexpr (boTraceEvents) {
+      static_assert((std::is_trivially_copyable_v<args_ty> && ...), "trace arguments must be trivially copyable");
+      static_assert(((alignof(args_ty) <= alignof(std::max_align_t)) && ...), "trace arguments with a too big alignment");
+      static constexpr auto slots = my_trace_detail::Slots<args_ty...>();
+      static_assert(slots.back() <= my_trace_record::max_args_size, "too many or too big arguments for a trace event");
+
+      my_trace_record record;
+      record.format = &my_trace_detail::Format<format, args_ty...>;
+      [&]<size_t... idx>(std::index_sequence<idx...>) {
+         (std::memcpy(record.args.data() + slots[idx], static_cast<void const*>(&args), sizeof(args_ty)), ...);
+         }(std::index_sequence_for<args_ty...> { });
+
+      if (auto* session = TTraceSession::Current(); session != nullptr) {
+         auto& ring = session->Ring();
+         while (!ring.Push(record)) session->Drain();
+         }
+      else record.format(std::cerr, record.args.data());
+      }
+   }
+
+/// format the pending events of the session now, before local data which the events refer to is released
+inline void TraceFlush() {
+   if constexpr (boTraceEvents)
+      if (auto* session = TTraceSession::Current(); session != nullptr) session->Drain();
+   }
+
+/// TraceFlush() at the end of the scope, also when an exception leaves it. declared behind the local data
+/// which the events refer to, it's destroyed and flushes before them
+class TTraceFlush {
+   public:
+      TTraceFlush(bool active = true) : boActive(active) { }
+      TTraceFlush(TTraceFlush const&) = delete;
+      ~TTraceFlush() { if (boActive) TraceFlush(); }
+
+      TTraceFlush& operator = (TTraceFlush const&) = delete;
+
+   private:
+      bool boActive;
+   };
+
 inline auto GetContent(std::filesystem::path const& strFile, std::string& strBuffer) {
    std::ifstream ifs(strFile);
    ifs.exceptions(std::ios_base::badbit);
@@ -109,88 +738,984 @@ inline auto GetContent(std::filesystem::path const& strFile, std::string& strBuf
       const auto iSize = std::filesystem::file_size(strFile);
       strBuffer.resize(iSize);
       ifs.read(strBuffer.data(), iSize);
+      // in text mode the stream can deliver less characters than the file size (\r\n -> \n)
+      strBuffer.resize(static_cast<size_t>(ifs.gcount()));
       return std::string_view { strBuffer.data(), strBuffer.size() };
       }
    }
 
+/// kind of access to an input file, buffered reads the file in a std::string (GetContent),
+/// mapped hands out a view to a memory mapping of the file, automatic decides with the file size
+enum class EInputMode : uint8_t { buffered, mapped, automatic };
+
+inline std::ostream& operator << (std::ostream& out, EInputMode const& mode) {
+   switch (mode) {
+      case EInputMode::buffered:  out << "buffered"; break;
+      case EInputMode::mapped:    out << "mapped"; break;
+      case EInputMode::automatic: out << "automatic"; break;
+      default: throw std::domain_error("unexpected value for input mode.");
+      }
+   return out;
+   }
+
+/// options for the memory mapping of input files
+struct my_mapping_options {
+   bool populate   = false;   ///< prefault all pages while mapping (MAP_POPULATE / PrefetchVirtualMemory)
+   bool sequential = true;    ///< advise the system that the file is read sequential (MADV_SEQUENTIAL)
+   };
+
+/// read only memory mapping of a complete file, implemented for posix systems and windows in aoc_lib.cpp
+class TMappedFile {
+   public:
+      TMappedFile() = delete;
+      TMappedFile(TMappedFile const&) = delete;
+      TMappedFile(TMappedFile&& other) noexcept { swap(other); }
+      TMappedFile(std::filesystem::path const& strFile, my_mapping_options const& options = { });
+      ~TMappedFile();
+
+      TMappedFile& operator = (TMappedFile const&) = delete;
+      TMappedFile& operator = (TMappedFile&& other) noexcept { swap(other); return *this; }
+
+      std::string_view View() const { return { theData, theSize }; }
+
+   private:
+      void swap(TMappedFile& other) noexcept {
+         std::swap(theData, other.theData);
+         std::swap(theSize, other.theSize);
+         std::swap(theHandle, other.theHandle);
+         }
+
+      const char* theData   = nullptr;
+      size_t      theSize   = 0u;
+      void*       theHandle = nullptr;   ///< handle of the mapping object (only windows)
+   };
+
+/// owner of the content of an input file, either as memory mapping or as copy in a string buffer.
+/// the buffered path is the fallback when the mapping isn't possible. the object can't copied or moved,
+/// because views to the content (my_lines) refer to it.
+class TInputSource {
+   public:
+      /// files with this size or greater are mapped in the mode EInputMode::automatic
+      static constexpr std::uintmax_t mapping_threshold = 1u << 20;
+
+      TInputSource() = delete;
+      TInputSource(TInputSource const&) = delete;
+      TInputSource(TInputSource&&) = delete;
+
+      TInputSource(std::filesystem::path const& strFile, EInputMode mode = EInputMode::automatic,
+                   my_mapping_options const& options = { }) {
+         if (mode == EInputMode::automatic)
+            mode = std::filesystem::file_size(strFile) >= mapping_threshold ? EInputMode::mapped : EInputMode::buffered;
+
+         if (mode == EInputMode::mapped) {
+            try {
+               theMapping.emplace(strFile, options);
+               theContent = theMapping->View();
+               theMode    = EInputMode::mapped;
+               return;
+               }
+            catch (std::exception&) {
+               theMapping.reset();   // fall through to the buffered path
+               }
+            }
+         theContent = GetContent(strFile, strBuffer);
+         theMode    = EInputMode::buffered;
+         }
+
+      std::string_view Content() const { return theContent; }
+      EInputMode       Mode() const { return theMode; }
+
+   private:
+      std::string                strBuffer;
+      std::optional<TMappedFile> theMapping;
+      std::string_view           theContent;
+      EInputMode                 theMode    = EInputMode::buffered;
+   };
+
+/// collect the positions of all '\n' in a text in one pass. the scan compares 16 characters at once
+/// with SSE2 and has a scalar fallback for other platforms. the table is reserved for lines of about
+/// 32 characters and grows geometric behind it, the text is read only once
+inline void ScanNewlines(std::string_view text, std::vector<size_t>& positions) {
+   const char* const first = text.data();
+   const size_t      iSize = text.size();
+
+   positions.clear();
+   positions.reserve(iSize / 32 + 16);
+   size_t pos = 0u;
+   #if defined(AOC_SSE2)
+      const __m128i newline = _mm_set1_epi8('\n');
+      for (; pos + 16 <= iSize; pos += 16) {
+         __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + pos));
+         unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+         while (mask != 0) {
+            positions.emplace_back(pos + std::countr_zero(mask));
+            mask &= mask - 1;
+            }
+         }
+   #endif
+   for (; pos < iSize; ++pos) if (first[pos] == '\n') positions.emplace_back(pos);
+   }
+
+/// table with the positions of the line ends in a text, build once with a vectorized scan.
+/// like the former sequential reading, only lines terminated with '\n' are part of the table.
+/// the same construction collects the blocks of non blank lines, separated by blank lines
+class my_line_index {
+   public:
+      /// first line and end (behind the last line) of a block
+      using block_bounds = std::pair<size_t, size_t>;
+
+      my_line_index() = default;
+      my_line_index(std::string_view text) {
+         ScanNewlines(text, line_ends);
+         // a line is blank when it is empty or contains only the carriage return of \r\n
+         auto blank = [this, &text](size_t idx) {
+            const size_t length = line_ends[idx] - LineBegin(idx);
+            return length == 0 || (length == 1 && text[line_ends[idx] - 1] == '\r');
+            };
+         for (size_t idx = 0, first = 0; idx <= line_ends.size(); ++idx) {
+            if (idx == line_ends.size() || blank(idx)) {
+               if (idx > first) blocks.emplace_back(first, idx);
+               first = idx + 1;
+               }
+            }
+         }
+
+      size_t size() const { return line_ends.size(); }
+
+      /// blocks of the text, blank lines in sequence don't create empty blocks
+      std::span<const block_bounds> Blocks() const { return blocks; }
+
+      /// offset of the first character in the line
+      size_t LineBegin(size_t idx) const { return idx == 0 ? 0u : line_ends[idx - 1] + 1; }
+      /// offset of the terminating '\n' of the line
+      size_t LineEnd(size_t idx) const { return line_ends[idx]; }
+
+      /// number of the first line which ends at or behind the offset, used to align chunks with lines
+      size_t LineAt(size_t offset) const {
+         return static_cast<size_t>(std::distance(line_ends.begin(), std::lower_bound(line_ends.begin(), line_ends.end(), offset)));
+         }
+
+      std::string_view Line(std::string_view text, size_t idx) const {
+         const size_t start = LineBegin(idx);
+         std::string_view line = text.substr(start, line_ends[idx] - start);
+         // mapped files aren't translated in text mode, remove the carriage return of \r\n
+         if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+         return line;
+         }
+
+   private:
+      std::vector<size_t>       line_ends;
+      std::vector<block_bounds> blocks;
+   };
+
 struct my_line_iterator {
-   using iterator_category = std::input_iterator_tag;
+   using iterator_concept  = std::random_access_iterator_tag;
+   using iterator_category = std::input_iterator_tag;   ///< lines are delivered as values
    using value_type        = std::string_view;
    using difference_type   = std::ptrdiff_t;
-   using reference_type    = value_type const&;
-   using pointer_type      = const value_type*;
+   using reference         = value_type;
+
+   my_line_iterator() = default;
+   my_line_iterator(std::string_view text, my_line_index const* index, size_t pos) : theText(text), theIndex(index), thePos(pos) { }
+
+   reference operator*() const { return theIndex->Line(theText, thePos); }
+   reference operator[](difference_type n) const { return theIndex->Line(theText, thePos + n); }
+
+   my_line_iterator& operator++() { ++thePos; return *this; }
+   my_line_iterator& operator--() { --thePos; return *this; }
+   my_line_iterator operator++(int) { auto elem(*this); ++thePos; return elem; }
+   my_line_iterator operator--(int) { auto elem(*this); --thePos; return elem; }
+
+   my_line_iterator& operator += (difference_type n) { thePos += n; return *this; }
+   my_line_iterator& operator -= (difference_type n) { thePos -= n; return *this; }
+
+   friend my_line_iterator operator + (my_line_iterator it, difference_type n) { return it += n; }
+   friend my_line_iterator operator + (difference_type n, my_line_iterator it) { return it += n; }
+   friend my_line_iterator operator - (my_line_iterator it, difference_type n) { return it -= n; }
+   friend difference_type operator - (my_line_iterator const& lhs, my_line_iterator const& rhs) {
+      return static_cast<difference_type>(lhs.thePos) - static_cast<difference_type>(rhs.thePos);
+      }
+
+   friend bool operator == (my_line_iterator const& lhs, my_line_iterator const& rhs) { return lhs.thePos == rhs.thePos; }
+   friend auto operator <=> (my_line_iterator const& lhs, my_line_iterator const& rhs) { return lhs.thePos <=> rhs.thePos; }
+
+   /// number of the line in the text
+   size_t Position() const { return thePos; }
+
+   private:
+      std::string_view     theText;
+      my_line_index const* theIndex = nullptr;
+      size_t               thePos   = 0u;
+   };
+
+/// block of consecutive non blank lines as zero copy view into the text, size() is the count of lines
+using my_block = std::ranges::subrange<my_line_iterator>;
+
+/// default combination for map_reduce and parallel_reduce, adds the result of a chunk to the total
+struct my_add_to {
+   template <typename ty>
+   void operator()(ty& total, ty&& part) const { total += part; }
+   };
+
+/// output of one job, collected instead of writing it to std::cout / std::cerr
+struct my_captured_output {
+   std::string strOut;
+   std::string strErr;
+   std::mutex  mutex;    ///< tasks of the job in other threads write into the same output
+   };
+
+/// stream buffer installed on std::cout or std::cerr for concurrent jobs. the text goes to the
+/// captured output of the current thread (TOutputCapture) or, without, to the original buffer.
+/// the buffer is shared by all threads and has no put area, each thread collects its text in an own
+/// pending buffer, moved into the captured output under the mutex when it's full, on sync / flush and
+/// when the capture of the thread ends. the formatting flags are those of std::cout / std::cerr, for
+/// formatted output the jobs use their own streams, TOutputCapture::Out() / Err()
+class TCaptureBuffer : public std::streambuf {
+   public:
+      TCaptureBuffer(std::ostream& stream, std::string my_captured_output::* target) :
+            theStream(stream), theTarget(target), theOriginal(stream.rdbuf(this)) { }
+      TCaptureBuffer(TCaptureBuffer const&) = delete;
+      ~TCaptureBuffer() { theStream.rdbuf(theOriginal); }
+
+      TCaptureBuffer& operator = (TCaptureBuffer const&) = delete;
+
+      /// captured output of the calling thread, nullptr when the output isn't captured
+      static my_captured_output*& Current() {
+         thread_local my_captured_output* current = nullptr;
+         return current;
+         }
+
+      /// moves the pending text of the calling thread into its captured output
+      static void Flush() {
+         auto& pending = Pending();
+         if (pending.output && !pending.text.empty()) {
+            std::scoped_lock lock(pending.output->mutex);
+            (pending.output->*pending.target) += pending.text;
+            }
+         pending.text.clear();
+         }
+
+   protected:
+      int_type overflow(int_type c) override {
+         if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+         if (auto output = Current(); output) {
+            const char ch = traits_type::to_char_type(c);
+            Append(output, &ch, 1);
+            return c;
+            }
+         return theOriginal->sputc(traits_type::to_char_type(c));
+         }
+
+      std::streamsize xsputn(const char* text, std::streamsize count) override {
+         if (auto output = Current(); output) {
+            Append(output, text, static_cast<size_t>(count));
+            return count;
+            }
+         return theOriginal->sputn(text, count);
+         }
+
+      int sync() override {
+         if (!Current()) return theOriginal->pubsync();
+         Flush();
+         return 0;
+         }
+
+   private:
+      /// text of a thread for one captured output and target, not yet in the output
+      struct pending_text {
+         my_captured_output*               output = nullptr;
+         std::string my_captured_output::* target = nullptr;
+         std::string                       text;
+         };
+
+      static constexpr size_t pending_size = 4096;
+
+      static pending_text& Pending() {
+         thread_local pending_text pending;
+         return pending;
+         }
+
+      void Append(my_captured_output* output, const char* text, size_t count) {
+         auto& pending = Pending();
+         if (pending.output != output || pending.target != theTarget) {
+            Flush();
+            pending.output = output;
+            pending.target = theTarget;
+            }
+         pending.text.append(text, count);
+         if (pending.text.size() >= pending_size) Flush();
+         }
+
+      std::ostream&                  theStream;
+      std::string my_captured_output::* theTarget;
+      std::streambuf*                theOriginal;
+   };
+
+/// the output of the current thread goes to 'output' while the object exists, nested captures restore the outer one
+class TOutputCapture {
+   public:
+      TOutputCapture(my_captured_output* output) : theOutput(output), thePrevious(Switch(output)),
+                                                   thePreviousCapture(std::exchange(Active(), this)) { }
+      TOutputCapture(TOutputCapture const&) = delete;
+      ~TOutputCapture() {
+         Switch(thePrevious);
+         Active() = thePreviousCapture;
+         }
+
+      TOutputCapture& operator = (TOutputCapture const&) = delete;
+
+      /// stream of the capture for std::cout / std::cerr with own formatting flags (setw, setfill, ...), the
+      /// flags of the global streams are shared by all jobs. the global stream itself without a capture
+      static std::ostream& Out() { return Stream(&TOutputCapture::theOut, std::cout, false); }
+      static std::ostream& Err() { return Stream(&TOutputCapture::theErr, std::cerr, true); }
+
+   private:
+      /// the pending text of the thread belongs to the capture before the switch
+      static my_captured_output* Switch(my_captured_output* output) {
+         TCaptureBuffer::Flush();
+         return std::exchange(TCaptureBuffer::Current(), output);
+         }
+
+      static TOutputCapture*& Active() {
+         thread_local TOutputCapture* active = nullptr;
+         return active;
+         }
+
+      /// created at the first use, most tasks of a job never write formatted output
+      static std::ostream& Stream(std::optional<std::ostream> TOutputCapture::* member, std::ostream& stream, bool boUnitBuf) {
+         auto capture = Active();
+         if (!capture || !capture->theOutput) return stream;
+         auto& own = capture->*member;
+         if (!own) {
+            own.emplace(stream.rdbuf());
+            if (boUnitBuf) own->setf(std::ios_base::unitbuf);
+            }
+         return *own;
+         }
+
+      my_captured_output*         theOutput;
+      my_captured_output*         thePrevious;
+      TOutputCapture*             thePreviousCapture;
+      std::optional<std::ostream> theOut;
+      std::optional<std::ostream> theErr;
+   };
+
+/// thrown by CheckCancelled(). deliberately not derived from std::exception, so the catch blocks of the
+/// riddles let it pass to the caller of the riddle
+struct my_riddle_cancelled {
+   bool boBudgetExceeded = false;   ///< the time budget was exceeded, otherwise cancelled by the user
+
+   std::string what() const { return boBudgetExceeded ? "time budget of the riddle exceeded"s : "riddle cancelled"s; }
+   };
+
+/// cooperative cancellation of the riddle in the current thread, requested by an outer stop token (the
+/// worker thread of the user interface) or when the optional time budget is exceeded. the riddles call
+/// CheckCancelled() in long loops, this is a load of the stop state while nothing is requested. while it
+/// exists, the object is the cancellation of the thread which created it. implemented in aoc_lib.cpp
+class TRiddleCancellation {
+   public:
+      TRiddleCancellation(std::stop_token outer = { }, std::optional<std::chrono::milliseconds> budget = { });
+      TRiddleCancellation(TRiddleCancellation const&) = delete;
+      ~TRiddleCancellation();
+
+      TRiddleCancellation& operator = (TRiddleCancellation const&) = delete;
+
+      void Cancel() { theSource.request_stop(); }
+      bool Requested() const { return theToken.stop_requested(); }
+      bool BudgetExceeded() const { return boBudgetExceeded.load(std::memory_order_acquire); }
+
+      /// cancellation of the calling thread, nullptr outside of a cancellable call
+      static TRiddleCancellation const*& Current() {
+         thread_local TRiddleCancellation const* current = nullptr;
+         return current;
+         }
+
+   private:
+      struct forward_stop {
+         std::stop_source source;
+         void operator()() { source.request_stop(); }
+         };
+
+      std::stop_source                                theSource;
+      std::stop_token                                 theToken;
+      std::optional<std::stop_callback<forward_stop>> theOuter;
+      std::atomic<bool>                               boBudgetExceeded = false;
+      TRiddleCancellation const*                      thePrevious;
+      std::jthread                                    theWatchdog;   ///< only with a budget, last member
+   };
 
-   my_line_iterator() { };
-   my_line_iterator(std::string_view const& input) : theText(input) { ++*this; };
+/// the cancellation of a caller for a task in another thread, restores the previous one at the end
+class TCancellationScope {
+   public:
+      TCancellationScope(TRiddleCancellation const* cancellation) :
+                  thePrevious(std::exchange(TRiddleCancellation::Current(), cancellation)) { }
+      TCancellationScope(TCancellationScope const&) = delete;
+      ~TCancellationScope() { TRiddleCancellation::Current() = thePrevious; }
 
-   my_line_iterator& operator = (std::string_view const& vw) {
-      theText = vw;
-      start_pos = 0u;
-      end_pos = 0u;
-      return *this;
+      TCancellationScope& operator = (TCancellationScope const&) = delete;
+
+   private:
+      TRiddleCancellation const* thePrevious;
+   };
+
+/// progress of the running riddle, the solver writes it with relaxed stores and the user interface polls it
+/// with a timer. steps and states are counted as the riddle needs it, total is 0 when the end isn't known
+struct my_progress {
+   std::atomic<uint64_t> steps  = 0u;
+   std::atomic<uint64_t> states = 0u;
+   std::atomic<uint64_t> total  = 0u;
+
+   void Steps(uint64_t value)  { steps.store(value, std::memory_order_relaxed); }
+   void States(uint64_t value) { states.store(value, std::memory_order_relaxed); }
+   void Total(uint64_t value)  { total.store(value, std::memory_order_relaxed); }
+
+   void Reset() {
+      Steps(0u);
+      States(0u);
+      Total(0u);
       }
+   };
+
+/// progress of the calling thread while the object exists, restores the previous one at the end
+class TProgressScope {
+   public:
+      TProgressScope(my_progress* progress) : thePrevious(std::exchange(Current(), progress)) { }
+      TProgressScope(TProgressScope const&) = delete;
+      ~TProgressScope() { Current() = thePrevious; }
+
+      TProgressScope& operator = (TProgressScope const&) = delete;
+
+      static my_progress*& Current() {
+         thread_local my_progress* current = nullptr;
+         return current;
+         }
+
+   private:
+      my_progress* thePrevious;
+   };
+
+/// progress of the riddle in the current thread, without a reader the values go to an unused object
+inline my_progress& RiddleProgress() {
+   thread_local my_progress unused;
+   auto progress = TProgressScope::Current();
+   return progress != nullptr ? *progress : unused;
+   }
+
+/// allocations with the global operator new / delete (replaced in aoc_lib.cpp) while a TAllocationScope
+/// is active. live and peak use the usable size of the blocks, blocks from before the scope aren't known
+struct my_allocation_stats {
+   std::atomic<uint64_t> count = 0u;   ///< calls of operator new
+   std::atomic<uint64_t> bytes = 0u;   ///< requested bytes
+   std::atomic<int64_t>  live  = 0;
+   std::atomic<int64_t>  peak  = 0;
+   };
+
+/// allocations of the calling thread are counted into stats while the object exists, the tasks started with
+/// a TTaskGroup too. without a scope operator new only checks the pointer, so the counting is opt-in
+class TAllocationScope {
+   public:
+      TAllocationScope(my_allocation_stats* stats) : thePrevious(std::exchange(Current(), stats)) { }
+      TAllocationScope(TAllocationScope const&) = delete;
+      ~TAllocationScope() { Current() = thePrevious; }
+
+      TAllocationScope& operator = (TAllocationScope const&) = delete;
+
+      static my_allocation_stats*& Current() {
+         thread_local my_allocation_stats* current = nullptr;
+         return current;
+         }
+
+   private:
+      my_allocation_stats* thePrevious;
+   };
 
-   my_line_iterator& operator = (my_line_iterator const& ref) {
-      theText = ref.theText;
-      theLine = ref.theLine;
-      start_pos = ref.start_pos;
-      end_pos = ref.end_pos;
-      return *this;
+/// memory counters of the process (getrusage, GetProcessMemoryInfo), implemented in aoc_lib.cpp
+struct my_process_memory {
+   uint64_t peak_rss     = 0u;   ///< bytes, peak of the whole process since its start
+   uint64_t minor_faults = 0u;   ///< page faults without I/O, windows counts all faults here
+   uint64_t major_faults = 0u;
+   };
+
+my_process_memory ProcessMemory();
+
+/// memory footprint of a run of a riddle. the page faults are the difference during the run, the
+/// peak rss belongs to the process, with concurrent runs both include the other riddles
+struct riddle_memory {
+   bool     boAllocations = false;   ///< allocations counted, the next 3 values are valid
+   uint64_t allocations   = 0u;
+   uint64_t bytes         = 0u;
+   uint64_t peak_live     = 0u;
+   uint64_t peak_rss      = 0u;
+   uint64_t minor_faults  = 0u;
+   uint64_t major_faults  = 0u;
+   };
+
+/// text for the log, e.g. "1234 allocations with 2.5 MiB, peak 1.2 MiB live, peak rss 20.1 MiB, 512 page faults (0 major)"
+std::string MemoryText(riddle_memory const& memory);
+
+/// hardware counters of a call, values the cpu or the kernel doesn't support are empty
+struct my_hardware_counters {
+   std::optional<uint64_t> cycles;
+   std::optional<uint64_t> instructions;
+   std::optional<uint64_t> l1d_misses;      ///< read misses of the level 1 data cache
+   std::optional<uint64_t> llc_misses;      ///< misses of the last level cache
+   std::optional<uint64_t> branch_misses;
+   std::string             strError;        ///< reason when the counters couldn't opened, e.g. perf_event_paranoid
+
+   bool Valid() const { return strError.empty(); }
+   std::optional<double> IPC() const {
+      if (!cycles || !instructions || *cycles == 0) return { };
+      return static_cast<double>(*instructions) / static_cast<double>(*cycles);
       }
+   };
+
+/// group of hardware counters for the calling thread (linux perf_event_open, user mode only), counting
+/// between Start() and Stop(). tasks in the thread pool aren't counted. the counters are opened in the
+/// constructor, when that isn't possible (permissions, other systems) Stop() returns the reason and no
+/// values, the riddle runs anyway. implemented in aoc_lib.cpp
+class TPerfCounters {
+   public:
+      TPerfCounters();
+      TPerfCounters(TPerfCounters const&) = delete;
+      ~TPerfCounters();
+
+      TPerfCounters& operator = (TPerfCounters const&) = delete;
 
-   reference_type operator*() const { return theLine; }
-   pointer_type operator->() const { return &theLine; }
+      void Start();
+      my_hardware_counters Stop();
+
+   private:
+      std::vector<std::pair<std::optional<uint64_t> my_hardware_counters::*, int>> theEvents;   ///< the leader first
+      std::string strError;
+   };
 
-   my_line_iterator& operator++() {
-      if (theText) {
-         end_pos = theText->find('\n', start_pos);
-         if (end_pos != std::string_view::npos) {
-            theLine = theText->substr(start_pos, end_pos - start_pos);
-            start_pos = end_pos + 1;
+/// text for the log, e.g. "2.1e+09 cycles, 4.3e+09 instructions, IPC 2.05, ..." or the reason without counters
+std::string HardwareCountersText(my_hardware_counters const& counters);
+
+/// collects the phases and counters of one run from all threads while the object exists (TPhaseTimer,
+/// PhaseCounter). MoveTo() hands them to the result of the riddle. implemented in aoc_lib.cpp
+class TPhaseRecorder {
+   public:
+      TPhaseRecorder();
+      TPhaseRecorder(TPhaseRecorder const&) = delete;
+      ~TPhaseRecorder();
+
+      TPhaseRecorder& operator = (TPhaseRecorder const&) = delete;
+
+      std::chrono::steady_clock::time_point Start() const { return theStart; }
+
+      void Add(riddle_phase&& phase);
+      /// counters with the same name are summed up
+      void Count(std::string_view name, int64_t value);
+      /// index of the calling thread in this run
+      uint32_t ThreadIndex();
+      /// append the phases in the order of their start and the counters to the result
+      void MoveTo(riddle_result& result);
+
+      static TPhaseRecorder*& Current() {
+         thread_local TPhaseRecorder* current = nullptr;
+         return current;
+         }
+
+   private:
+      std::chrono::steady_clock::time_point theStart;
+      std::mutex                            theMutex;
+      std::vector<riddle_phase>             thePhases;
+      std::vector<riddle_counter>           theCounters;
+      std::vector<std::thread::id>          theThreads;
+      TPhaseRecorder*                       thePrevious;
+   };
+
+/// RAII timer for a phase of the riddle, e.g. TPhaseTimer phase("parse"). timers inside the scope of
+/// another timer in the same thread are its sub phases. without a recorder the timer does nothing
+class TPhaseTimer {
+   public:
+      TPhaseTimer(std::string_view name) : theRecorder(TPhaseRecorder::Current()) {
+         if (theRecorder != nullptr) {
+            theName  = name;
+            iDepth   = Depth()++;
+            theStart = std::chrono::steady_clock::now();
             }
-         else {
-            //theText = { };
-            theText = std::nullopt;
+         }
+
+      TPhaseTimer(TPhaseTimer const&) = delete;
+
+      ~TPhaseTimer() {
+         if (theRecorder != nullptr) {
+            auto theEnd = std::chrono::steady_clock::now();
+            --Depth();
+            theRecorder->Add({ std::move(theName), theEnd - theStart, theStart - theRecorder->Start(), iDepth, theRecorder->ThreadIndex() });
             }
          }
-      return *this;
+
+      TPhaseTimer& operator = (TPhaseTimer const&) = delete;
+
+   private:
+      static uint32_t& Depth() {
+         thread_local uint32_t depth = 0;
+         return depth;
+         }
+
+      TPhaseRecorder*                       theRecorder;
+      std::string                           theName;
+      std::chrono::steady_clock::time_point theStart;
+      uint32_t                              iDepth = 0;
+   };
+
+/// adds value to the named counter of the run, e.g. PhaseCounter("beams spawned", 1)
+inline void PhaseCounter(std::string_view name, int64_t value) {
+   if (auto recorder = TPhaseRecorder::Current(); recorder != nullptr) recorder->Count(name, value);
+   }
+
+/// throws my_riddle_cancelled when the cancellation of the current thread is requested
+inline void CheckCancelled() {
+   if (auto cancellation = TRiddleCancellation::Current(); cancellation && cancellation->Requested()) [[unlikely]]
+      throw my_riddle_cancelled { cancellation->BudgetExceeded() };
+   }
+
+/// work stealing scheduler for the parallel parts of the riddles, started once per process with
+/// Instance() and shared by all callers. every worker owns a deque, takes its newest task first and
+/// steals the oldest tasks of the other workers when it runs out of work. tasks from other threads
+/// go to a shared queue. threads waiting for tasks (TTaskGroup::Wait) execute pending tasks instead
+/// of blocking, so nested parallel calls can't dead lock. implemented in aoc_lib.cpp
+class TThreadPool {
+   public:
+      using task_ty = std::function<void()>;
+
+      /// pool of the process with one worker less than the hardware threads, the waiting caller is the last
+      static TThreadPool& Instance();
+
+      TThreadPool(size_t workers);
+      TThreadPool(TThreadPool const&) = delete;
+      TThreadPool(TThreadPool&&) = delete;
+      ~TThreadPool();
+
+      TThreadPool& operator = (TThreadPool const&) = delete;
+      TThreadPool& operator = (TThreadPool&&) = delete;
+
+      /// count of threads which execute tasks, the workers and the waiting caller
+      size_t Concurrency() const { return theWorkers.size() + 1; }
+
+      /// queue a task, tasks must not throw (TTaskGroup catches the exceptions of its tasks)
+      void Submit(task_ty task);
+      /// queue a whole job (a riddle of --all or --batch). jobs are taken by idle workers and by threads
+      /// waiting for a group of jobs, never by a riddle waiting for its own tasks, so jobs don't nest
+      void SubmitJob(task_ty task);
+      /// execute one pending task in the calling thread, with boJobs jobs too, false when there is nothing
+      bool RunOne(bool boJobs = false);
+      /// block the calling thread until a task (with boJobs or a job) is pending or done() is true. done()
+      /// is checked again with every Notify(), it must only change before a call of Notify()
+      template <typename pred_ty>
+      void WaitIdle(pred_ty done, bool boJobs = false) {
+         std::unique_lock lock(theMutex);
+         theCondition.wait(lock, [this, &done, boJobs]() {
+            return iPending.load(std::memory_order_acquire) > 0u || (boJobs && iJobs.load(std::memory_order_acquire) > 0u) || done();
+            });
+         }
+      /// wake the threads in WaitIdle() to check their condition again
+      void Notify() {
+         std::scoped_lock lock(theMutex);
+         theCondition.notify_all();
+         }
+
+      /// call func(idx) for all idx in [first, last) in 'chunks' parts (0 = 4 parts per thread)
+      template <typename func_ty>
+      void parallel_for(size_t first, size_t last, func_ty func, size_t chunks = 0);
+
+      /// accumulate(acc_ty&, size_t idx) for all idx in [first, last), every part starts with a copy of identity.
+      /// the results of the parts are combined in their order, so the result is deterministic for a count of chunks
+      template <typename acc_ty, typename accumulate_fn, typename combine_fn = my_add_to>
+      acc_ty parallel_reduce(size_t first, size_t last, acc_ty const& identity, accumulate_fn accumulate,
+                             combine_fn combine = { }, size_t chunks = 0);
+
+   private:
+      struct queue_ty {
+         std::mutex          mutex;
+         std::deque<task_ty> tasks;
+         };
+
+      std::optional<task_ty> Take(size_t index);
+      std::optional<task_ty> TakeJob();
+      void Work(std::stop_token token, size_t index);
+
+      std::vector<std::unique_ptr<queue_ty>> theQueues;      ///< one per worker, the shared queue is the last
+      queue_ty                               theJobs;        ///< jobs in the order of their submit
+      std::atomic<size_t>                    iPending = 0u;
+      std::atomic<size_t>                    iJobs = 0u;
+      std::mutex                             theMutex;
+      std::condition_variable_any            theCondition;
+      std::vector<std::jthread>              theWorkers;     ///< last member, stopped and joined first
+   };
+
+/// group of tasks in the thread pool. Wait() helps to execute tasks until all tasks of the group are
+/// finished and rethrows the first exception of them. the destructor waits too, without exception
+class TTaskGroup {
+   public:
+      TTaskGroup(TThreadPool& pool = TThreadPool::Instance()) : thePool(pool) { }
+      TTaskGroup(TTaskGroup const&) = delete;
+      TTaskGroup(TTaskGroup&&) = delete;
+      ~TTaskGroup() { Join(); }
+
+      TTaskGroup& operator = (TTaskGroup const&) = delete;
+      TTaskGroup& operator = (TTaskGroup&&) = delete;
+
+      template <typename func_ty>
+      void Run(func_ty&& func) {
+         thePool.Submit(Task(std::forward<func_ty>(func)));
+         }
+
+      /// run a whole job with the pool (TThreadPool::SubmitJob), Wait() executes jobs of the pool too
+      template <typename func_ty>
+      void RunJob(func_ty&& func) {
+         boJobs = true;
+         thePool.SubmitJob(Task(std::forward<func_ty>(func)));
+         }
+
+      void Wait() {
+         Join();
+         if (theError) std::rethrow_exception(std::exchange(theError, nullptr));
+         }
+
+   private:
+      template <typename func_ty>
+      TThreadPool::task_ty Task(func_ty&& func) {
+         iRemaining.fetch_add(1u, std::memory_order_relaxed);
+         // the task writes into the same captured output, trace, progress, phases and allocations and stops with
+         // the same cancellation as the caller, in which thread ever it runs. the arena of the caller isn't
+         // synchronized, the task allocates from the default resource, even when a waiting riddle runs it
+         return [this, output = TCaptureBuffer::Current(), cancellation = TRiddleCancellation::Current(),
+                         progress = TProgressScope::Current(), recorder = TPhaseRecorder::Current(),
+                         allocations = TAllocationScope::Current(), trace = TTraceSession::Current(),
+                         func = std::forward<func_ty>(func)]() mutable {
+            TOutputCapture     capture(output);
+            TCancellationScope scope(cancellation);
+            TProgressScope     progress_scope(progress);
+            TAllocationScope   allocation_scope(allocations);
+            auto previous_recorder = std::exchange(TPhaseRecorder::Current(), recorder);
+            auto previous_resource = std::exchange(my_arena_detail::current_resource, nullptr);
+            auto previous_trace    = std::exchange(TTraceSession::Current(), trace);
+            try {
+               func();
+               }
+            catch (...) {
+               std::scoped_lock lock(theMutex);
+               if (!theError) theError = std::current_exception();
+               }
+            my_arena_detail::current_resource = previous_resource;
+            TTraceSession::Current() = previous_trace;
+            TPhaseRecorder::Current() = previous_recorder;
+            // the group can be destroyed as soon as the count is 0, the pool outlives it
+            auto& pool = thePool;
+            if (iRemaining.fetch_sub(1u, std::memory_order_acq_rel) == 1u) pool.Notify();
+            };
+         }
+
+      /// execute pending tasks while the group isn't finished, sleep when there is nothing to execute
+      void Join() {
+         while (iRemaining.load(std::memory_order_acquire) > 0u)
+            if (!thePool.RunOne(boJobs)) thePool.WaitIdle([this]() { return iRemaining.load(std::memory_order_acquire) == 0u; }, boJobs);
+         }
+
+      TThreadPool&        thePool;
+      bool                boJobs = false;   ///< the group has jobs, only used by the thread which owns the group
+      std::atomic<size_t> iRemaining = 0u;
+      std::mutex          theMutex;
+      std::exception_ptr  theError;
+   };
+
+template <typename func_ty>
+void TThreadPool::parallel_for(size_t first, size_t last, func_ty func, size_t chunks) {
+   const size_t iCount = last > first ? last - first : 0u;
+   if (chunks == 0) chunks = 4 * Concurrency();
+   chunks = std::max<size_t>(1u, std::min(chunks, iCount));
+
+   if (chunks == 1) {
+      for (size_t idx = first; idx < last; ++idx) func(idx);
+      return;
       }
 
-   my_line_iterator operator++(int) {
-      auto elem(*this);
-      ++*this;
-      return elem;
+   TTaskGroup group(*this);
+   for (size_t k = 0; k < chunks; ++k) {
+      group.Run([&func, k, first, iCount, chunks]() {
+         TPhaseTimer phase("chunk");
+         for (size_t idx = first + iCount * k / chunks; idx < first + iCount * (k + 1) / chunks; ++idx) func(idx);
+         });
+      }
+   group.Wait();
+   }
+
+template <typename acc_ty, typename accumulate_fn, typename combine_fn>
+acc_ty TThreadPool::parallel_reduce(size_t first, size_t last, acc_ty const& identity, accumulate_fn accumulate,
+                                    combine_fn combine, size_t chunks) {
+   const size_t iCount = last > first ? last - first : 0u;
+   if (chunks == 0) chunks = Concurrency();
+   chunks = std::max<size_t>(1u, std::min(chunks, iCount));
+
+   // the results are constructed in the tasks, local accumulators without false sharing
+   std::vector<std::optional<acc_ty>> partial(chunks);
+   auto work = [&](size_t k) {
+      TPhaseTimer phase("chunk");
+      acc_ty local = identity;
+      for (size_t idx = first + iCount * k / chunks; idx < first + iCount * (k + 1) / chunks; ++idx) accumulate(local, idx);
+      partial[k].emplace(std::move(local));
+      };
+
+   if (chunks == 1) work(0);
+   else {
+      TTaskGroup group(*this);
+      for (size_t k = 0; k < chunks; ++k) group.Run([&work, k]() { work(k); });
+      group.Wait();
       }
 
-   friend  bool operator == (my_line_iterator const& lhs, my_line_iterator const& rhs) {
-      return lhs.theText == rhs.theText;
+   acc_ty result = identity;
+   for (auto& part : partial) combine(result, std::move(*part));
+   return result;
+   }
+
+/// number of threads for the parallel algorithms, the concurrency of the thread pool
+inline size_t DefaultConcurrency() {
+   return TThreadPool::Instance().Concurrency();
+   }
+
+/// view to the lines of a text. the line index is build once while construction and is shared
+/// by all copies, so random access, size() and repeated traversals don't scan the text again
+struct my_lines : std::ranges::view_interface<my_lines> {
+   my_lines() = default;
+   my_lines(std::string_view const& input) : theText(input), theIndex(std::make_shared<const my_line_index>(input)) { }
+   my_lines(my_lines const& ref) = default;
+   my_lines(my_lines&& ref) noexcept = default;
+
+   my_lines& operator = (my_lines const& ref) = default;
+   my_lines& operator = (my_lines&& ref) noexcept = default;
+
+   my_line_iterator begin() const { return my_line_iterator(theText, theIndex.get(), 0u); }
+   my_line_iterator end() const { return my_line_iterator(theText, theIndex.get(), size()); }
+
+   size_t size() const { return theIndex ? theIndex->size() : 0u; }
+   /// line without a range check like std::vector, the riddles check size() for their input errors
+   std::string_view operator[](size_t idx) const { return theIndex->Line(theText, idx); }
+
+   /// random access view to the blocks separated by blank lines (my_block), they are found while
+   /// the construction, so the lines aren't split or copied again
+   auto blocks() const {
+      std::span<const my_line_index::block_bounds> bounds;
+      if (theIndex) bounds = theIndex->Blocks();
+      return bounds | std::views::transform([text = theText, index = theIndex.get()](auto const& block) {
+                         return my_block(my_line_iterator(text, index, block.first), my_line_iterator(text, index, block.second));
+                         });
       }
 
-   friend  bool operator != (my_line_iterator const& lhs, my_line_iterator const& rhs) {
-      return !(lhs == rhs);
+   /// split the lines in 'chunks' parts with nearly the same count of characters, the result contains
+   /// the number of the first line for each chunk and the end as last element (chunks + 1 values)
+   std::vector<size_t> ChunkBounds(size_t chunks) const {
+      std::vector<size_t> bounds(chunks + 1, size());
+      bounds[0] = 0u;
+      const size_t iBytes = size() > 0 ? theIndex->LineEnd(size() - 1) + 1 : 0u;
+      for (size_t k = 1; k < chunks; ++k)
+         bounds[k] = std::max(bounds[k - 1], theIndex->LineAt(iBytes * k / chunks));
+      return bounds;
       }
 
-   std::string AsString() {
-      if (!theText) throw std::runtime_error("text isn't initialize.");
-      else return to_String(trim(*theText));
+   /// process all lines in newline aligned chunks in the thread pool. every chunk starts with a copy
+   /// of 'identity' (must be the neutral element) and calls accumulate(acc_ty&, std::string_view) for
+   /// each of its lines. the results of the chunks are combined in the order of the chunks with
+   /// combine(acc_ty&, acc_ty&&), so the result is deterministic for a given count of chunks.
+   /// chunks = 0 uses DefaultConcurrency(), chunks = 1 runs sequential in the calling thread
+   /// (use it when the accumulation writes to streams). the first exception of a chunk is rethrown.
+   template <typename acc_ty, typename accumulate_fn, typename combine_fn = my_add_to>
+   acc_ty map_reduce(acc_ty const& identity, accumulate_fn accumulate, combine_fn combine = { }, size_t chunks = 0) const {
+      if (chunks == 0) chunks = DefaultConcurrency();
+      chunks = std::max<size_t>(1u, std::min(chunks, size()));
+
+      const auto bounds = ChunkBounds(chunks);
+      // the results are constructed in the workers, so they don't allocate from the arena of the caller
+      std::vector<std::optional<acc_ty>> partial(chunks);
+      std::vector<std::exception_ptr> errors(chunks);
+
+      auto work = [&](size_t k) {
+         try {
+            acc_ty local = identity;   // local accumulator, no false sharing between the threads
+            for (size_t i = bounds[k]; i < bounds[k + 1]; ++i) accumulate(local, (*this)[i]);
+            partial[k].emplace(std::move(local));
+            }
+         catch (...) {
+            errors[k] = std::current_exception();
+            }
+         };
+
+      if (chunks == 1) work(0);
+      else {
+         TTaskGroup group;
+         for (size_t k = 0; k < chunks; ++k) group.Run([&work, k]() { work(k); });
+         group.Wait();
+         }
+
+      for (auto const& error : errors) if (error) std::rethrow_exception(error);
+
+      acc_ty result = identity;
+      for (auto& part : partial) combine(result, std::move(*part));
+      return result;
       }
 
-   private:
-      std::optional<std::string_view> theText = { };
-      std::string_view                theLine;
-      size_t                          start_pos = 0u, end_pos = 0u;
+   std::string_view theText;
+   std::shared_ptr<const my_line_index> theIndex;
    };
 
-struct my_lines {
-   my_lines(std::string_view const& input) { theText = input; }
-   my_lines(my_lines const& ref) { theText = ref.theText; }
+/// lines of a file which is read in blocks of fixed size, for inputs larger than the memory. a background
+/// thread fills one of two buffers while the other is processed (double buffering). a line which is cut
+/// at the end of a block is carried to the begin of the next one, so every block contains only complete
+/// lines and the memory stays bounded by two blocks plus the longest line. only useful for riddles
+/// which process the lines independent, the reading and thread handling is in aoc_lib.cpp
+class my_stream_lines {
+   public:
+      static constexpr size_t default_block_size = 64u << 20;
+      /// files with this size or greater are streamed by the caller when the riddle supports it
+      static constexpr std::uintmax_t streaming_threshold = std::uintmax_t { 1 } << 30;
 
-   my_line_iterator begin() const { return my_line_iterator(theText); }
-   my_line_iterator end() const { return my_line_iterator(); }
+      my_stream_lines() = delete;
+      my_stream_lines(my_stream_lines const&) = delete;
+      my_stream_lines(my_stream_lines&&) = delete;
+      my_stream_lines(std::filesystem::path const& strFile, size_t block_size = default_block_size);
 
+      my_stream_lines& operator = (my_stream_lines const&) = delete;
+      my_stream_lines& operator = (my_stream_lines&&) = delete;
 
-   std::string_view theText;
+      /// lines of the next block or std::nullopt at the end of the file. the lines stay valid until
+      /// the next call, an error of the reading thread is rethrown here
+      std::optional<my_lines> Next();
+
+      /// count of the blocks delivered so far
+      size_t Blocks() const { return iBlocks; }
+
+      /// same contract as my_lines::map_reduce, the blocks are processed one after the other with
+      /// map_reduce of my_lines and combined in the order of the file
+      template <typename acc_ty, typename accumulate_fn, typename combine_fn = my_add_to>
+      acc_ty map_reduce(acc_ty const& identity, accumulate_fn accumulate, combine_fn combine = { }, size_t chunks = 0) {
+         acc_ty result = identity;
+         while (auto block = Next()) combine(result, block->map_reduce(identity, accumulate, combine, chunks));
+         return result;
+         }
+
+   private:
+      struct block_ty {
+         std::string      data;
+         std::string_view content;
+         bool             filled = false;   ///< true while the block waits for or is in processing
+         };
+
+      void Read(std::stop_token token);
 
+      std::ifstream               ifs;
+      const size_t                iBlockSize;
+      std::array<block_ty, 2>     theBlocks;
+      size_t                      iCurrent    = 0u;
+      size_t                      iBlocks     = 0u;
+      bool                        boDelivered = false;
+      bool                        boFinished  = false;
+      std::exception_ptr          theError;
+      std::mutex                  theMutex;
+      std::condition_variable_any theCondition;
+      std::jthread                theReader;   ///< last member, stopped and joined first
    };
 
 struct my_line {